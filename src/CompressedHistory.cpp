@@ -0,0 +1,231 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ CompressedHistory.cpp
+ Created on: Oct 17, 2026
+ */
+#include "CompressedHistory.h"
+
+namespace {
+  constexpr uint8_t DELTA_BITS = 3;
+  constexpr uint8_t DELTA_ESCAPE = (1 << DELTA_BITS) - 1;
+  constexpr uint8_t MAX_TOKEN_LEN = 10;
+
+  uint8_t putVarint(uint32_t value, uint8_t* out) {
+    uint8_t len = 0;
+    while (value >= 0x80) {
+      out[len++] = (value & 0x7F) | 0x80;
+      value >>= 7;
+    }
+    out[len++] = value;
+    return len;
+  }
+
+  uint32_t getVarint(const uint8_t* in, uint8_t& offset) {
+    uint32_t value = 0;
+    uint8_t shift = 0;
+    uint8_t b;
+    do {
+      b = in[offset++];
+      value |= (uint32_t)(b & 0x7F) << shift;
+      shift += 7;
+    } while (b & 0x80);
+    return value;
+  }
+
+  inline uint32_t zigzag(int value) {
+    return (value << 1) ^ (value >> 31);
+  }
+
+  inline int unzigzag(uint32_t value) {
+    return (value >> 1) ^ -(int)(value & 1);
+  }
+}
+
+CompressedHistory::CompressedHistory(Block* memory) : blocks(memory), count(0), listener(nullptr) {
+}
+
+void CompressedHistory::setListener(HistoryListener* listener) {
+  this->listener = listener;
+}
+
+uint8_t CompressedHistory::encode(uint32_t dtSec, int dh, int dt, uint8_t* out) {
+  uint32_t zz = zigzag(dh);
+  if ((zz < DELTA_ESCAPE) and (dt == 0)) {
+    return putVarint((dtSec << DELTA_BITS) | zz, out);
+  }
+  uint8_t len = putVarint((dtSec << DELTA_BITS) | DELTA_ESCAPE, out);
+  len += putVarint((zz << 1) | (dt != 0 ? 1 : 0), out + len);
+  if (dt != 0) {
+    len += putVarint(zigzag(dt), out + len);
+  }
+  return len;
+}
+
+void CompressedHistory::startBlock(const Measurement& m) {
+  Block block;
+  block.timestamp = m.timestamp;
+  block.humidity = m.humidity;
+  block.temperature = m.temperature;
+  block.count = 1;
+  block.used = 0;
+  if (blocks.full()) {
+    count -= blocks.front().count;
+    if (listener != nullptr) {
+      for(const_iterator iter = begin(); iter.block == 0; ++iter) {
+        listener->onRemoved(*iter);
+      }
+    }
+  }
+  blocks.push_back(block);
+  last = m;
+  count++;
+  if (listener != nullptr) {
+    listener->onAdded(m);
+  }
+}
+
+void CompressedHistory::push_back(const Measurement& m) {
+  if (blocks.empty()) {
+    startBlock(m);
+    return;
+  }
+
+  uint32_t dtSec = m.timestamp - last.timestamp;
+  //time delta has to fit into 32 bit token next to humidity delta
+  if (dtSec >= (1UL << (32 - DELTA_BITS - 1))) {
+    startBlock(m);
+    return;
+  }
+  uint8_t token[MAX_TOKEN_LEN];
+  uint8_t len = encode(dtSec, m.humidity - last.humidity, m.temperature - last.temperature, token);
+
+  Block& block = blocks.back();
+  if ((block.used + len > sizeof(block.data)) or (block.count == 255)) {
+    startBlock(m);
+    return;
+  }
+  memcpy(block.data + block.used, token, len);
+  block.used += len;
+  block.count++;
+  count++;
+  last = m;
+  if (listener != nullptr) {
+    listener->onAdded(m);
+  }
+}
+
+void CompressedHistory::clear() {
+  blocks.clear();
+  count = 0;
+  last = Measurement();
+  if (listener != nullptr) {
+    listener->onCleared();
+  }
+}
+
+Measurement CompressedHistory::front() const {
+  if (blocks.empty()) {
+    return Measurement();
+  }
+  const Block& block = blocks.front();
+  return Measurement(block.timestamp, block.humidity, block.temperature);
+}
+
+CompressedHistory::const_iterator CompressedHistory::from(std::size_t index) const {
+  std::size_t block = 0;
+  while ((block < blocks.size()) and (index >= blocks[block].count)) {
+    index -= blocks[block].count;
+    block++;
+  }
+  const_iterator iter(this, block);
+  while ((index > 0) and (iter != end())) {
+    ++iter;
+    index--;
+  }
+  return iter;
+}
+
+CompressedHistory::const_iterator CompressedHistory::lowerBound(uint32_t timestamp) const {
+  //last block which starts not later than timestamp
+  std::size_t lo = 0;
+  std::size_t hi = blocks.size();
+  while (lo < hi) {
+    std::size_t mid = (lo + hi) / 2;
+    if (blocks[mid].timestamp <= timestamp) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  const_iterator iter(this, lo > 0 ? lo - 1 : 0);
+  while ((iter != end()) and (iter->timestamp < timestamp)) {
+    ++iter;
+  }
+  return iter;
+}
+
+CompressedHistory::const_iterator::const_iterator(const CompressedHistory* owner, std::size_t block) :
+    owner(owner), block(block), index(0), offset(0) {
+  load();
+}
+
+void CompressedHistory::const_iterator::load() {
+  index = 0;
+  offset = 0;
+  if (block < owner->blocks.size()) {
+    const Block& b = owner->blocks[block];
+    current = Measurement(b.timestamp, b.humidity, b.temperature);
+  }
+}
+
+CompressedHistory::const_iterator& CompressedHistory::const_iterator::operator++() {
+  const Block& b = owner->blocks[block];
+  index++;
+  if (index >= b.count) {
+    block++;
+    load();
+    return *this;
+  }
+
+  uint32_t token = getVarint(b.data, offset);
+  uint32_t zz = token & DELTA_ESCAPE;
+  if (zz == DELTA_ESCAPE) {
+    zz = getVarint(b.data, offset);
+    if (zz & 1) {
+      current.temperature += unzigzag(getVarint(b.data, offset));
+    }
+    zz >>= 1;
+  }
+  current.timestamp += token >> DELTA_BITS;
+  current.humidity += unzigzag(zz);
+  return *this;
+}
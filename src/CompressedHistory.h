@@ -0,0 +1,130 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ CompressedHistory.h
+ Created on: Oct 17, 2026
+ */
+#ifndef CompressedHistory_hpp
+#define CompressedHistory_hpp
+
+#include <Arduino.h>
+#include <iterator>
+#include "Measurement.h"
+#include "misc/RingBuffer.h"
+
+//Observer of samples entering and leaving CompressedHistory
+class HistoryListener {
+  public:
+    virtual ~HistoryListener() = default;
+    virtual void onAdded(const Measurement& m) = 0;
+    //called for every sample of dropped block, oldest first
+    virtual void onRemoved(const Measurement& m) = 0;
+    virtual void onCleared() = 0;
+};
+
+//Change-only measurements packed into fixed size blocks. Each block starts
+//with absolute sample, following samples are stored as single varint token:
+//  (seconds since previous << 3) | zigzag(humidity delta)
+//zigzag value 7 is an escape, varint (zigzag(humidity delta) << 1 | T) follows,
+//when T is set also varint zigzag(temperature delta). Temperature changes
+//rarely, so typical sample (few seconds, +-1%) still takes one byte. When
+//full, whole oldest block is dropped.
+class CompressedHistory {
+  public:
+    static constexpr std::size_t BLOCK_SIZE = 64;
+    static constexpr std::size_t BLOCK_COUNT = 32;
+
+    struct __attribute__ ((packed)) Block {
+      uint32_t timestamp;
+      int8_t humidity;
+      int8_t temperature;
+      uint8_t count;
+      uint8_t used;
+      uint8_t data[BLOCK_SIZE - 8];
+    };
+
+    class const_iterator {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Measurement value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Measurement* pointer;
+        typedef const Measurement& reference;
+
+        const_iterator(const CompressedHistory* owner, std::size_t block);
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+        const_iterator& operator++();
+        const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+        bool operator==(const const_iterator& other) const {
+          return (block == other.block) and (index == other.index);
+        }
+        bool operator!=(const const_iterator& other) const { return not (*this == other); }
+      private:
+        friend class CompressedHistory;
+        const CompressedHistory* owner;
+        std::size_t block;
+        uint8_t index;
+        uint8_t offset;
+        Measurement current;
+
+        void load();
+    };
+
+    explicit CompressedHistory(Block* memory);
+
+    void push_back(const Measurement& m);
+    void clear();
+    void setListener(HistoryListener* listener);
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    Measurement front() const;
+    const Measurement& back() const { return last; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, blocks.size()); }
+    //iterator pointing at index-th oldest sample, skips whole blocks without decoding
+    const_iterator from(std::size_t index) const;
+    //first sample not older than timestamp, binary search on block headers
+    const_iterator lowerBound(uint32_t timestamp) const;
+  private:
+    RingBuffer<Block, BLOCK_COUNT> blocks;
+    std::size_t count;
+    Measurement last;
+    HistoryListener* listener;
+
+    void startBlock(const Measurement& m);
+    static uint8_t encode(uint32_t dtSec, int dh, int dt, uint8_t* out);
+};
+
+#endif /* CompressedHistory_hpp */
@@ -4,14 +4,16 @@
 
 #include "Disturber.h"
 #include "misc/Prefs.h"
+#include "misc/TriggerPolicy.h"
 
 Disturber::Disturber(Fan& fan) : fan(fan) {}
 
 void Disturber::update(int humidity) {
-  if (fan.shouldRun == false && humidity > prefs.storage.humidityTrigger) {
+  if (fan.shouldRun == false && triggerPolicy.isExceeded(humidity)) {
     offTime++;
     if (offTime == prefs.storage.disturberTriggerTime) {
       fan.shouldRun = true;
+      fan.cause = FanCause_DISTURBER;
     }
 
   } else {
@@ -35,84 +35,250 @@
  */
 #include <EnvLogic.h>
 #include "misc/Prefs.h"
-#include "heuristic/AdaptiveHeuristic.h"
-#include "heuristic/AdaptiveHeuristic2.h"
-#include "heuristic/LimiterHeuristic.h"
-#include "heuristic/NiceToHaveHeuristic.h"
-
-namespace {
-  constexpr float ETA = 0.9;
-  constexpr int MEAS_COUNT = 60;
-  Measurement measurementBuff[MEAS_COUNT];
-}
+#include "FlashLog.h"
+#include "TraceCapture.h"
+#include "misc/Clock.h"
+#include "misc/TriggerPolicy.h"
 
 EnvLogic envLogic;
 
+static_assert(sizeof(SavedPrefs::statsWindow) / sizeof(SavedPrefs::statsWindow[0]) == EnvLogic::STATS_COUNT,
+    "prefs hold window of every stats");
+
 EnvLogic::EnvLogic() :
-    humAverage(0), measurements(
-        PreAllocator<Measurement>(measurementBuff, sizeof(MEAS_COUNT))), requestedRunToMillis(0), lastUpdate(0) {
+    humAverage(), hasTemperature(false), lastTemperature(0), retries(0), requestedRunTo(0), lastUpdate(0),
+    hasSample(false), rawCount(0), decisions(0) {
 
   pinMode(UNUSED_CTRL_PIN, OUTPUT);
   digitalWrite(UNUSED_CTRL_PIN, LOW);
   fan.shouldRun = false;
-
-  heuristics.push_back(new LimiterHeuristic(fan));
-  heuristics.push_back(new AdaptiveHeuristic(fan));
-  heuristics.push_back(new AdaptiveHeuristic2(fan));
-  heuristics.push_back(new NiceToHaveHeuristic(fan));
 }
 
 void EnvLogic::requestRunFor(int seconds) {
-  requestedRunToMillis = millis() + seconds * 1000;
+  requestedRunTo = systemClock.now() + seconds * 1000UL;
   fan.shouldRun = true;
-}
-
-int EnvLogic::getMaxAllowedHum() {
-  return prefs.storage.humidityTrigger;
+  fan.cause = FanCause_MANUAL;
 }
 
 bool EnvLogic::isTooWet() {
-  return getHumidity() > getMaxAllowedHum();
+  return triggerPolicy.isExceeded(getHumidity());
 }
 
 bool EnvLogic::fanIsRequested() {
-  return (millis() < (unsigned long) requestedRunToMillis);
+  return systemClock.now() < requestedRunTo;
 }
 
 int EnvLogic::getHumidity() {
-  return static_cast<int>(humAverage);
+  //truncated like before, heuristics are tuned on whole percents
+  return humAverage.getRaw() / Fixed::ONE;
+}
+
+int8_t EnvLogic::getTemperature() {
+  return hasTemperature ? temperature.toInt() : Measurement::NO_TEMPERATURE;
+}
+
+const SHT21& EnvLogic::getSensor() const {
+  return sht;
 }
 
 void EnvLogic::update() {
-  if (millis() - lastUpdate > 1000) {
-    //low-pass filter
-    humAverage = (1.0f - ETA) * sht.getHumidity() + ETA * humAverage;
-    lastUpdate = millis();
-  }
+  updateSensor();
 
-  fan.shouldRun = isTooWet() or fanIsRequested();
+  //heuristics need real humidity, so control starts with first sample
+  if (hasSample) {
+    for(uint32_t due = controlTicker.poll(systemClock.now()); due > 0; due--) {
+      filterTick();
+      controlTick();
+    }
+  }
   fan.update();
 
   collectMeasurementIfNeeded();
 }
 
+uint32_t EnvLogic::getIdleTime() {
+  if (sht.getState() != SHT21State_IDLE) {
+    return CONVERSION_POLL;
+  }
+  uint64_t now = systemClock.now();
+  uint64_t due = lastUpdate + getSampleInterval();
+  if (hasSample and (controlTicker.getNextTick() < due)) {
+    due = controlTicker.getNextTick();
+  }
+  return due > now ? due - now : 0;
+}
+
+void EnvLogic::controlTick() {
+  int humidity = getHumidity();
+  uint8_t bits = 0;
+  for(const HeuristicInfo& info : HeuristicSet::REGISTERED) {
+    Fan& proxy = heuristics.getFan(info.id);
+    proxy.cause = FanCause_HEURISTIC;
+    uint32_t start = micros();
+    heuristics.update(info.id, humidity);
+    timings[info.id].add(micros() - start);
+    //apply same mute times as real fan
+    proxy.update();
+    if (proxy.isRunning()) {
+      bits |= 1 << info.id;
+    }
+  }
+  decisions = bits;
+  history.addDecisions(systemClock.seconds(), bits);
+
+  const Fan& selected = heuristics.getFan(getSelectedHeuristic());
+  fan.shouldRun = selected.shouldRun;
+  fan.cause = selected.cause;
+  //manual request wins over heuristic
+  if (fanIsRequested()) {
+    fan.shouldRun = true;
+    fan.cause = FanCause_MANUAL;
+  }
+}
+
+void EnvLogic::updateSensor() {
+  switch(sht.poll()) {
+    case SHT21State_IDLE:
+      triggerIfDue();
+      break;
+
+    case SHT21State_READY:
+      retries = 0;
+      takeReading(sht.isTemperature(), sht.fetch());
+      //don't wait for next loop, it may come later than fast interval
+      if (sht.getState() == SHT21State_IDLE) {
+        triggerIfDue();
+      }
+      break;
+
+    case SHT21State_ERROR:
+      retryOrGiveUp();
+      break;
+
+    default:
+    case SHT21State_CONVERTING:
+      break;
+  }
+}
+
+//Readings are kept on grid of interval, so jitter of main loop does not
+//lower the rate. Grid starts over when reading is late by whole interval
+//(stall or switch from slower mode).
+void EnvLogic::triggerIfDue() {
+  uint64_t now = systemClock.now();
+  uint32_t interval = getSampleInterval();
+  if (now - lastUpdate < interval) {
+    return;
+  }
+  lastUpdate = now - lastUpdate < 2 * interval ? lastUpdate + interval : now;
+  sht.triggerHumidity();
+}
+
+//capture needs full rate to be useful for tuning
+uint32_t EnvLogic::getSampleInterval() const {
+  return traceCapture.isActive() ? AdaptiveSampler::INTERVALS[SamplingMode_FAST] : sampler.getInterval();
+}
+
+void EnvLogic::takeReading(bool isTemperature, uint16_t raw) {
+  if (isTemperature) {
+    temperature = SHT21::rawToTemperatureFixed(raw);
+    hasTemperature = true;
+    triggerPolicy.setTemperature(temperature);
+  } else {
+    addHumidity(SHT21::rawToHumidityFixed(raw));
+  }
+  traceCapture.add(raw, isTemperature, humAverage, fan.isRunning());
+}
+
+void EnvLogic::addHumidity(Fixed humidity) {
+  sampler.update(systemClock.now(), humidity, fan.isRunning());
+  rawSum += humidity;
+  rawCount++;
+  lastRaw = humidity;
+  if (not hasSample) {
+    //first value is shown at once, not on next tick
+    hasSample = true;
+    filterTick();
+  }
+
+  //temperature conversion follows humidity in same cycle
+  if (systemClock.now() - lastTemperature >= TEMPERATURE_INTERVAL) {
+    lastTemperature = systemClock.now();
+    sht.triggerTemperature();
+  }
+}
+
+//Pipeline runs once per control tick whatever sampling mode is, so median
+//window, Kalman noise and rate limit keep their meaning in seconds. Readings
+//of fast mode are averaged, in slower modes last reading is held.
+void EnvLogic::filterTick() {
+  Fixed input = rawCount > 0 ? rawSum / rawCount : lastRaw;
+  rawSum = Fixed();
+  rawCount = 0;
+  pipeline.assemble(prefs.storage.pipeline);
+  humAverage = pipeline.update(input);
+  history.addSample(systemClock.seconds(), getHumidity());
+  for(std::size_t t = 0; t < STATS_COUNT; t++) {
+    stats[t].setWindow(prefs.storage.statsWindow[t] * 60UL);
+    stats[t].add(systemClock.now(), humAverage, isTooWet());
+  }
+}
+
+//Failed read (bad CRC, timeout or no ACK) is repeated at once, when all
+//retries fail humidity keeps last value and temperature is marked unknown.
+void EnvLogic::retryOrGiveUp() {
+  bool wasTemperature = sht.isTemperature();
+  sht.clear();
+  if (retries < MAX_RETRIES) {
+    retries++;
+    sensorHealth.retries++;
+    if (wasTemperature) {
+      sht.triggerTemperature();
+    } else {
+      sht.triggerHumidity();
+    }
+    return;
+  }
+
+  retries = 0;
+  sensorHealth.failures++;
+  Serial.println(wasTemperature ? "SHT21: temperature read failed" : "SHT21: humidity read failed");
+  if (wasTemperature) {
+    hasTemperature = false;
+    triggerPolicy.clearTemperature();
+  }
+}
+
 void EnvLogic::collectMeasurementIfNeeded() {
-  unsigned long mil = millis();
-  if (measurements.size() > 0) {
-    const Measurement& mes = measurements.back();
-    if (getHumidity() != mes.humidity) {
-      addMeasurement(mil);
+  uint32_t sec = systemClock.seconds();
+  if (history.raw.size() > 0) {
+    const Measurement& mes = history.raw.back();
+    if ((getHumidity() != mes.humidity) or (getStoredTemperature(mes.temperature) != mes.temperature)) {
+      addMeasurement(sec);
     }
   } else {
-    addMeasurement(mil);
+    addMeasurement(sec);
   }
 }
 
-void EnvLogic::addMeasurement(unsigned long mil) {
-  if (measurements.size() == MEAS_COUNT) {
-    measurements.erase(measurements.begin());
+//Whole degrees to store, temperature close to half degree would flip
+//rounded value with every reading, so stored one is kept until temperature
+//is further than hysteresis from its band.
+int8_t EnvLogic::getStoredTemperature(int8_t stored) {
+  const Fixed HYSTERESIS = Fixed::ratio(1, 4);
+  if ((not hasTemperature) or (stored == Measurement::NO_TEMPERATURE)) {
+    return getTemperature();
   }
-  measurements.push_back(Measurement(mil, getHumidity()));
+  Fixed distance = temperature - Fixed(stored);
+  bool outside = (distance > Fixed::ratio(1, 2) + HYSTERESIS) or (distance < -Fixed::ratio(1, 2) - HYSTERESIS);
+  return outside ? getTemperature() : stored;
+}
+
+void EnvLogic::addMeasurement(uint32_t sec) {
+  int8_t stored = history.raw.empty() ? Measurement::NO_TEMPERATURE : history.raw.back().temperature;
+  Measurement m(sec, getHumidity(), getStoredTemperature(stored));
+  history.addRaw(m);
+  flashLog.append(m);
 }
 
 bool EnvLogic::isFanRunning() {
@@ -126,9 +292,9 @@ String EnvLogic::getDisplayHum() {
 }
 
 String EnvLogic::getDisplayFan() {
-  long fanTime;
-  if (millis() < (unsigned long) requestedRunToMillis) {
-    fanTime = requestedRunToMillis - millis();
+  uint32_t fanTime;
+  if (fanIsRequested()) {
+    fanTime = requestedRunTo - systemClock.now();
 
   } else {
     fanTime = millis() - fan.getTurnOnFanMillis();
@@ -136,7 +302,7 @@ String EnvLogic::getDisplayFan() {
   return "Nawiew " + millisToTime(fanTime);
 }
 
-String millisToTime(long mil) {
+String millisToTime(uint32_t mil) {
   String text;
   mil /= 1000;
   if (mil < 60) {
@@ -154,10 +320,10 @@ String millisToTime(long mil) {
   return text;
 }
 
-Heuristic* EnvLogic::getSelectedHeuristic() {
-  int i = prefs.storage.selectedHeuristic;
-  if ((i >= (int) heuristics.size()) or (i < 0)) {
-    i = 0;
-  }
-  return heuristics[i];
+HeuristicId_t EnvLogic::getSelectedHeuristic() {
+  return HeuristicSet::select(prefs.storage.selectedHeuristic);
+}
+
+uint8_t EnvLogic::getDecisions() const {
+  return decisions;
 }
@@ -36,44 +36,120 @@
 #ifndef EnvLogic_hpp
 #define EnvLogic_hpp
 
-#include "Measurement.h"
+#include "History.h"
 #include "periphery/Fan.h"
-#include "heuristic/Heuristic.h"
+#include "heuristic/HeuristicSet.h"
 #include "periphery/SHT21.h"
-#include "misc/PreAllocator.h"
-#include <vector>
+#include "misc/RunningStats.h"
+#include "misc/TickScheduler.h"
+#include "misc/SignalPipeline.h"
+#include "misc/AdaptiveSampler.h"
+
+typedef RunningStats<20> HumidityStats;
+
+//time spent in Heuristic::update()
+struct HeuristicTiming {
+  uint32_t calls = 0;
+  uint32_t lastMicros = 0;
+  uint32_t maxMicros = 0;
+  uint64_t totalMicros = 0;
+
+  void add(uint32_t micros) {
+    calls++;
+    lastMicros = micros;
+    maxMicros = micros > maxMicros ? micros : maxMicros;
+    totalMicros += micros;
+  }
+
+  uint32_t getMean() const {
+    return calls > 0 ? totalMicros / calls : 0;
+  }
+};
+
+//SHT21 reads repeated after error and reads given up after all retries
+struct SensorHealth {
+  uint32_t retries = 0;
+  uint32_t failures = 0;
+};
 
 class EnvLogic {
   public:
-    float humAverage;
-    std::vector<Measurement, PreAllocator<Measurement>> measurements;
+    static constexpr std::size_t STATS_COUNT = 3;
+    //temperature changes slowly, measuring it more often would warm sensor
+    static constexpr uint32_t TEMPERATURE_INTERVAL = 5000;
+    //main loop period while SHT21 conversion is pending
+    static constexpr uint32_t CONVERSION_POLL = 10;
+
+    Fixed humAverage;
+    History history;
+    //windows from prefs, by default 10 minutes, 1 hour and 1 day
+    HumidityStats stats[STATS_COUNT];
+    //drives selected heuristic, heuristics count time in ticks. In slow
+    //sampling mode they see same value for 30 ticks and then a step, per
+    //tick trends (Holt, Adaptive windows) read it as short burst. Step is
+    //small, change faster than activeRate switches sampling to fast mode.
+    TickScheduler controlTicker{1000};
+    //all heuristics run every tick, only selected one drives fan
+    HeuristicTiming timings[HeuristicId_COUNT];
+    //raw humidity -> humAverage, once per control tick
+    SignalPipeline pipeline;
+    SensorHealth sensorHealth;
+    //sensor polling interval follows humidity activity
+    AdaptiveSampler sampler;
 
     EnvLogic();
     void update();
+    //ms until next reading or control tick is due, main loop may sleep
+    uint32_t getIdleTime();
     String getDisplayHum();
     String getDisplayFan();
     bool isFanRunning();
     void requestRunFor(int seconds);
     int getHumidity();
+    //whole degrees C, Measurement::NO_TEMPERATURE until first valid read
+    int8_t getTemperature();
+    const SHT21& getSensor() const;
+    //bit i set when i-th heuristic keeps its fan running
+    uint8_t getDecisions() const;
+    HeuristicId_t getSelectedHeuristic();
   private:
     const uint8_t FAN_CONTROL_PIN = 12;
     const uint8_t UNUSED_CTRL_PIN = 13;
+    const uint8_t MAX_RETRIES = 2;
     SHT21 sht;
-    Fan fan{FAN_CONTROL_PIN};
-    long requestedRunToMillis;
-    long lastUpdate;
-    std::vector<Heuristic*> heuristics;
+    Fixed temperature;
+    bool hasTemperature;
+    uint64_t lastTemperature;
+    uint8_t retries;
+    Fan fan{FAN_CONTROL_PIN, &fanLog};
+    uint64_t requestedRunTo;  //systemClock.now() based
+    uint64_t lastUpdate;  //grid slot of last humidity reading
+    bool hasSample;
+    //raw readings since last filterTick()
+    Fixed rawSum;
+    uint8_t rawCount;
+    Fixed lastRaw;
+    uint8_t decisions;
+    //every heuristic controls own proxy fan, fan follows selected one
+    HeuristicSet heuristics{history.raw};
 
-    int getMaxAllowedHum();
-    void addMeasurement(unsigned long mil);
+    void addMeasurement(uint32_t sec);
 
+    void updateSensor();
+    uint32_t getSampleInterval() const;
+    void triggerIfDue();
+    void takeReading(bool isTemperature, uint16_t raw);
+    void addHumidity(Fixed humidity);
+    void filterTick();
+    void retryOrGiveUp();
     bool isTooWet();
     bool fanIsRequested();
     void collectMeasurementIfNeeded();
-    Heuristic* getSelectedHeuristic();
+    int8_t getStoredTemperature(int8_t stored);
+    void controlTick();
 };
 
 extern EnvLogic envLogic;
-String millisToTime(long mil);
+String millisToTime(uint32_t mil);
 
 #endif /* EnvLogic_hpp */
@@ -0,0 +1,327 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ FlashLog.cpp
+ Created on: Oct 17, 2026
+ */
+#include "FlashLog.h"
+#include <LittleFS.h>
+#include <algorithm>
+#include "misc/Clock.h"
+
+FlashLog flashLog;
+
+namespace {
+  constexpr uint32_t SEGMENT_MAGIC = 0x484C4733;  //"HLG3"
+  constexpr uint32_t SEGMENT_MAGIC_V2 = 0x484C4732;  //"HLG2", humidity only, read only
+  const char* LOG_DIR = "/log";
+
+  struct __attribute__ ((packed)) SegmentHeader {
+    uint32_t magic;
+    uint32_t seq;
+    uint16_t boot;
+    uint32_t bootEpoch;
+  };
+
+  struct __attribute__ ((packed)) LogRecord {
+    uint32_t timestamp;
+    int8_t humidity;
+    int8_t temperature;
+    uint8_t crc;
+  };
+
+  struct __attribute__ ((packed)) LogRecordV2 {
+    uint32_t timestamp;
+    int8_t humidity;
+    uint8_t crc;
+  };
+
+  FlashLog::SegmentInfo segmentBuff[FlashLog::MAX_SEGMENTS];
+
+  uint8_t calcCRC(const uint8_t* data, int len) {
+    uint8_t crc = 0x00;
+    while (len--) {
+      byte extract = *data++;
+      for (byte tempI = 8; tempI; tempI--) {
+        byte sum = (crc ^ extract) & 0x01;
+        crc >>= 1;
+        if (sum) {
+          crc ^= 0x8C;
+        }
+        extract >>= 1;
+      }
+    }
+    return crc;
+  }
+
+  String segmentPath(uint32_t seq) {
+    String path(LOG_DIR);
+    path += "/";
+    path += seq;
+    return path;
+  }
+}
+
+FlashLog::FlashLog() : segments(segmentBuff), ready(false), boot(0), nextSeq(0),
+    lastFlush(0), pendingCount(0), brokenSegment(false) {
+}
+
+void FlashLog::begin() {
+  ready = LittleFS.begin();
+  if (not ready) {
+    Serial.println("FlashLog: no filesystem");
+    return;
+  }
+  LittleFS.mkdir(LOG_DIR);
+  scan();
+  Serial.print("FlashLog: boot ");
+  Serial.print(boot);
+  Serial.print(", segments ");
+  Serial.println(segments.size());
+}
+
+bool FlashLog::isReady() const {
+  return ready;
+}
+
+uint16_t FlashLog::getBoot() const {
+  return boot;
+}
+
+//Builds index from segment headers and sizes only, records are validated
+//when they are read.
+void FlashLog::scan() {
+  SegmentInfo found[MAX_SEGMENTS];
+  std::size_t foundCount = 0;
+  Dir dir = LittleFS.openDir(LOG_DIR);
+  while (dir.next()) {
+    String name = dir.fileName();
+    name = name.substring(name.lastIndexOf('/') + 1);
+    SegmentInfo info;
+    if (not scanSegment(segmentPath(name.toInt()), info)) {
+      LittleFS.remove(segmentPath(name.toInt()));
+      continue;
+    }
+    if (foundCount == MAX_SEGMENTS) {
+      //keep newest ones, replace oldest
+      std::size_t oldest = 0;
+      for(std::size_t t = 1; t < foundCount; t++) {
+        oldest = found[t].seq < found[oldest].seq ? t : oldest;
+      }
+      if (found[oldest].seq > info.seq) {
+        LittleFS.remove(segmentPath(info.seq));
+        continue;
+      }
+      LittleFS.remove(segmentPath(found[oldest].seq));
+      found[oldest] = info;
+
+    } else {
+      found[foundCount++] = info;
+    }
+  }
+
+  std::sort(found, found + foundCount, [](const SegmentInfo& a, const SegmentInfo& b) {
+    return a.seq < b.seq;
+  });
+  segments.clear();
+  for(std::size_t t = 0; t < foundCount; t++) {
+    segments.push_back(found[t]);
+  }
+  if (segments.empty()) {
+    boot = 0;
+    nextSeq = 0;
+  } else {
+    boot = segments.back().boot + 1;
+    nextSeq = segments.back().seq + 1;
+  }
+}
+
+bool FlashLog::scanSegment(const String& path, SegmentInfo& info) {
+  File file = LittleFS.open(path, "r");
+  if (not file) {
+    return false;
+  }
+  SegmentHeader header;
+  bool valid = (file.read((uint8_t*)&header, sizeof(header)) == sizeof(header))
+      and ((header.magic == SEGMENT_MAGIC) or (header.magic == SEGMENT_MAGIC_V2));
+  if (valid) {
+    info.seq = header.seq;
+    info.boot = header.boot;
+    info.bootEpoch = header.bootEpoch;
+    info.recordSize = header.magic == SEGMENT_MAGIC ? sizeof(LogRecord) : sizeof(LogRecordV2);
+    //torn tail of last write is ignored
+    info.count = (file.size() - sizeof(header)) / info.recordSize;
+    info.first = 0;
+    info.last = 0;
+    //both formats start with timestamp
+    uint32_t timestamp;
+    if ((info.count > 0) and (file.read((uint8_t*)&timestamp, sizeof(timestamp)) == sizeof(timestamp))) {
+      info.first = timestamp;
+      file.seek(sizeof(header) + (info.count - 1) * info.recordSize);
+      if (file.read((uint8_t*)&timestamp, sizeof(timestamp)) == sizeof(timestamp)) {
+        info.last = timestamp;
+      }
+    }
+  }
+  file.close();
+  return valid;
+}
+
+void FlashLog::append(const Measurement& m) {
+  if (not ready) {
+    return;
+  }
+  //flash keeps failing, oldest pending record is lost
+  if (pendingCount == PENDING_COUNT) {
+    std::copy(pending + 1, pending + PENDING_COUNT, pending);
+    pendingCount--;
+  }
+  pending[pendingCount++] = m;
+  if (pendingCount == PENDING_COUNT) {
+    flush();
+  }
+}
+
+void FlashLog::update() {
+  if (ready and (pendingCount > 0) and (millis() - lastFlush >= FLUSH_INTERVAL)) {
+    flush();
+  }
+}
+
+//Starts new segment in index and on flash, must be called before first
+//write of each boot and when current segment is full.
+bool FlashLog::openSegment() {
+  if (segments.full()) {
+    dropOldestSegment();
+  }
+  SegmentHeader header = {SEGMENT_MAGIC, nextSeq, boot, systemClock.getBootEpoch()};
+  File file = LittleFS.open(segmentPath(nextSeq), "w");
+  if (not file) {
+    return false;
+  }
+  bool written = file.write((uint8_t*)&header, sizeof(header)) == sizeof(header);
+  file.close();
+  if (not written) {
+    LittleFS.remove(segmentPath(nextSeq));
+    return false;
+  }
+
+  SegmentInfo info = {nextSeq, boot, 0, header.bootEpoch, 0, 0, sizeof(LogRecord)};
+  segments.push_back(info);
+  nextSeq++;
+  return true;
+}
+
+void FlashLog::dropOldestSegment() {
+  LittleFS.remove(segmentPath(segments.front().seq));
+  segments.pop_front();
+}
+
+void FlashLog::flush() {
+  lastFlush = millis();
+  if ((not ready) or (pendingCount == 0)) {
+    return;
+  }
+
+  std::size_t written = 0;
+  bool failed = false;
+  while ((written < pendingCount) and (not failed)) {
+    bool needSegment = segments.empty() or (segments.back().boot != boot) or brokenSegment or
+        (sizeof(SegmentHeader) + (segments.back().count + 1) * sizeof(LogRecord) > SEGMENT_SIZE);
+    if (needSegment) {
+      if (not openSegment()) {
+        break;
+      }
+      brokenSegment = false;
+    }
+
+    SegmentInfo& info = segments.back();
+    File file = LittleFS.open(segmentPath(info.seq), "a");
+    if (not file) {
+      break;
+    }
+    while ((written < pendingCount) and
+        (sizeof(SegmentHeader) + (info.count + 1) * sizeof(LogRecord) <= SEGMENT_SIZE)) {
+      const Measurement& m = pending[written];
+      LogRecord rec = {m.timestamp, m.humidity, m.temperature, 0};
+      rec.crc = calcCRC((uint8_t*)&rec, sizeof(rec) - 1);
+      if (file.write((uint8_t*)&rec, sizeof(rec)) != sizeof(rec)) {
+        //torn record would shift following ones, continue in new segment
+        brokenSegment = true;
+        failed = true;
+        break;
+      }
+      if (info.count == 0) {
+        info.first = m.timestamp;
+      }
+      info.last = m.timestamp;
+      info.count++;
+      written++;
+    }
+    file.close();
+  }
+  //unwritten records wait for next flush
+  std::copy(pending + written, pending + pendingCount, pending);
+  pendingCount -= written;
+}
+
+void FlashLog::clear() {
+  pendingCount = 0;
+  while (not segments.empty()) {
+    dropOldestSegment();
+  }
+}
+
+bool FlashLog::read(uint32_t seq, std::function<void(const Measurement&)> callback) {
+  uint8_t recordSize = 0;
+  for(const SegmentInfo& info : segments) {
+    recordSize = info.seq == seq ? info.recordSize : recordSize;
+  }
+  File file = recordSize > 0 ? LittleFS.open(segmentPath(seq), "r") : File();
+  if (not file) {
+    return false;
+  }
+  file.seek(sizeof(SegmentHeader));
+  uint8_t rec[sizeof(LogRecord)];
+  while (file.read(rec, recordSize) == recordSize) {
+    if (calcCRC(rec, recordSize - 1) == rec[recordSize - 1]) {
+      Measurement m;
+      memcpy(&m.timestamp, rec, sizeof(m.timestamp));
+      m.humidity = rec[offsetof(LogRecord, humidity)];
+      if (recordSize == sizeof(LogRecord)) {
+        m.temperature = rec[offsetof(LogRecord, temperature)];
+      }
+      callback(m);
+    }
+  }
+  file.close();
+  return true;
+}
@@ -0,0 +1,94 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ FlashLog.h
+ Created on: Oct 17, 2026
+ */
+#ifndef FlashLog_hpp
+#define FlashLog_hpp
+
+#include <Arduino.h>
+#include <functional>
+#include "Measurement.h"
+#include "misc/RingBuffer.h"
+
+//Append only log of change-only measurements on LittleFS. Log is split into
+//small segment files, oldest segment is deleted when limit is reached. Each
+//boot starts new segment, timestamps are seconds since that boot, segment
+//header keeps boot counter and unix time of boot (if SNTP was available).
+class FlashLog {
+  public:
+    static constexpr std::size_t MAX_SEGMENTS = 32;
+    static constexpr std::size_t SEGMENT_SIZE = 2048;
+    static constexpr std::size_t PENDING_COUNT = 128;
+    static constexpr unsigned long FLUSH_INTERVAL = 10 * 60 * 1000UL;
+
+    struct SegmentInfo {
+      uint32_t seq;
+      uint16_t boot;
+      uint16_t count;
+      uint32_t bootEpoch;
+      uint32_t first;
+      uint32_t last;
+      uint8_t recordSize;  //segments from older firmware have no temperature
+    };
+
+    RingBuffer<SegmentInfo, MAX_SEGMENTS> segments;
+
+    FlashLog();
+    void begin();
+    void append(const Measurement& m);
+    void update();
+    void flush();
+    void clear();
+    bool isReady() const;
+    uint16_t getBoot() const;
+    //calls callback for each record with valid crc, false if segment is unknown
+    bool read(uint32_t seq, std::function<void(const Measurement&)> callback);
+  private:
+    bool ready;
+    uint16_t boot;
+    uint32_t nextSeq;
+    unsigned long lastFlush;
+    Measurement pending[PENDING_COUNT];
+    std::size_t pendingCount;
+    //last append to current segment failed, next record starts new one
+    bool brokenSegment;
+
+    void scan();
+    bool scanSegment(const String& path, SegmentInfo& info);
+    bool openSegment();
+    void dropOldestSegment();
+};
+
+extern FlashLog flashLog;
+
+#endif /* FlashLog_hpp */
@@ -0,0 +1,85 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ History.cpp
+ Created on: Oct 17, 2026
+ */
+#include "History.h"
+#include <algorithm>
+
+namespace {
+  CompressedHistory::Block rawBuff[CompressedHistory::BLOCK_COUNT];
+  Rollup minuteBuff[History::MINUTE_COUNT];
+  Rollup hourBuff[History::HOUR_COUNT];
+  ShadowDecision decisionBuff[History::DECISION_COUNT];
+}
+
+History::History() :
+    raw(rawBuff), minutes(minuteBuff, 60), hours(hourBuff, 3600), decisions(decisionBuff) {
+}
+
+void History::addRaw(const Measurement& m) {
+  raw.push_back(m);
+}
+
+void History::addSample(uint32_t timestamp, int8_t humidity) {
+  Rollup closed;
+  //start of bucket being accumulated, empty buckets may follow it when closed
+  uint32_t openStart = minutes.getTimestamp(minutes.items.size());
+  if (minutes.add(timestamp, Rollup(humidity, humidity, humidity), closed)) {
+    Rollup unused;
+    hours.add(openStart, closed, unused);
+  }
+}
+
+void History::addDecisions(uint32_t timestamp, uint8_t bits) {
+  if (decisions.empty() or (decisions.back().bits != bits)) {
+    decisions.push_back(ShadowDecision{timestamp, bits});
+  }
+}
+
+uint8_t History::getDecisions(uint32_t timestamp) const {
+  //last change not later than timestamp
+  auto iter = decisionsAfter(timestamp);
+  return iter == decisions.begin() ? 0 : (iter - 1)->bits;
+}
+
+RingBuffer<ShadowDecision, History::DECISION_COUNT>::const_iterator History::decisionsAfter(uint32_t timestamp) const {
+  return std::upper_bound(decisions.begin(), decisions.end(), timestamp,
+      [](uint32_t ts, const ShadowDecision& d) { return ts < d.timestamp; });
+}
+
+void History::clear() {
+  raw.clear();
+  minutes.clear();
+  hours.clear();
+  decisions.clear();
+}
@@ -0,0 +1,157 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ History.h
+ Created on: Oct 17, 2026
+ */
+#ifndef History_hpp
+#define History_hpp
+
+#include <Arduino.h>
+#include "CompressedHistory.h"
+#include "misc/RingBuffer.h"
+
+//min/avg/max of humidity over one bucket of a tier
+class __attribute__ ((packed)) Rollup {
+  public:
+    int8_t min;
+    int8_t avg;
+    int8_t max;
+    Rollup() : min(0), avg(0), max(0) {};
+    Rollup(int8_t min, int8_t avg, int8_t max) : min(min), avg(avg), max(max) {}
+
+    //bucket without any sample, min > max marks it
+    static Rollup empty() {
+      return Rollup(INT8_MAX, 0, INT8_MIN);
+    }
+
+    bool isEmpty() const {
+      return min > max;
+    }
+};
+
+//Downsampled history, buckets are consecutive so only start of the
+//currently accumulated bucket is stored, rest of timestamps are derived.
+template<std::size_t N>
+class RollupTier {
+  public:
+    RingBuffer<Rollup, N> items;
+
+    //timestamps and period in seconds
+    RollupTier(Rollup* memory, uint32_t period) : items(memory), period(period) {}
+
+    //Accumulates sample into current bucket, when sample belongs to next
+    //bucket current one is closed, stored and returned in closed.
+    bool add(uint32_t timestamp, const Rollup& sample, Rollup& closed) {
+      uint32_t start = timestamp - timestamp % period;
+      bool wasClosed = false;
+      if (count == 0) {
+        bucketStart = start;
+
+      } else if (start != bucketStart) {
+        closed = Rollup(minVal, sum / count, maxVal);
+        items.push_back(closed);
+        //keep timeline continuous if we missed whole buckets
+        uint32_t gap = (start - bucketStart) / period;
+        for(uint32_t t = 1; (t < gap) && (t <= N); t++) {
+          items.push_back(Rollup::empty());
+        }
+        bucketStart = start;
+        count = 0;
+        wasClosed = true;
+      }
+
+      if ((count == 0) or (sample.min < minVal)) {
+        minVal = sample.min;
+      }
+      if ((count == 0) or (sample.max > maxVal)) {
+        maxVal = sample.max;
+      }
+      sum = count == 0 ? sample.avg : sum + sample.avg;
+      count++;
+      return wasClosed;
+    }
+
+    //start time of i-th stored bucket
+    uint32_t getTimestamp(std::size_t i) const {
+      return bucketStart - (items.size() - i) * period;
+    }
+
+    uint32_t getPeriod() const {
+      return period;
+    }
+
+    void clear() {
+      items.clear();
+      count = 0;
+    }
+  private:
+    uint32_t period;
+    uint32_t bucketStart = 0;
+    int32_t sum = 0;
+    uint16_t count = 0;
+    int8_t minVal = 0;
+    int8_t maxVal = 0;
+};
+
+//Decisions of all heuristics run in shadow, bit i is set when i-th
+//heuristic wants fan running. Valid from timestamp until next change.
+struct __attribute__ ((packed)) ShadowDecision {
+  uint32_t timestamp;
+  uint8_t bits;
+};
+
+class History {
+  public:
+    static constexpr std::size_t MINUTE_COUNT = 12 * 60;
+    static constexpr std::size_t HOUR_COUNT = 7 * 24;
+    static constexpr std::size_t DECISION_COUNT = 256;
+
+    CompressedHistory raw;
+    RollupTier<MINUTE_COUNT> minutes;
+    RollupTier<HOUR_COUNT> hours;
+    //change-only
+    RingBuffer<ShadowDecision, DECISION_COUNT> decisions;
+
+    History();
+    //change-only readings
+    void addRaw(const Measurement& m);
+    //every reading, feeds downsampling tiers
+    void addSample(uint32_t timestamp, int8_t humidity);
+    void addDecisions(uint32_t timestamp, uint8_t bits);
+    //decisions which were valid at timestamp, 0 if not known
+    uint8_t getDecisions(uint32_t timestamp) const;
+    //first change of decisions later than timestamp
+    RingBuffer<ShadowDecision, DECISION_COUNT>::const_iterator decisionsAfter(uint32_t timestamp) const;
+    void clear();
+};
+
+#endif /* History_hpp */
@@ -40,10 +40,14 @@
 
 class __attribute__ ((packed)) Measurement {
   public:
-    uint32_t timestamp;
+    static constexpr int8_t NO_TEMPERATURE = INT8_MIN;
+
+    uint32_t timestamp;  //seconds since boot, see Clock
     int8_t humidity;
-    Measurement() : timestamp(0), humidity(0) {};
-    Measurement(int32_t timestamp, int8_t humidity) : timestamp(timestamp), humidity(humidity) {}
+    int8_t temperature;  //whole degrees C, NO_TEMPERATURE if not measured
+    Measurement() : timestamp(0), humidity(0), temperature(NO_TEMPERATURE) {};
+    Measurement(uint32_t timestamp, int8_t humidity, int8_t temperature = NO_TEMPERATURE) :
+        timestamp(timestamp), humidity(humidity), temperature(temperature) {}
 };
 
 #endif /* Measurement_hpp */
@@ -39,12 +39,23 @@
 #include <ESP8266mDNS.h>
 #include <ESP8266WebServer.h>
 #include <ArduinoJson.h>
+#include <LittleFS.h>
 #include "EnvLogic.h"
 #include "misc/Prefs.h"
 #include "Updater.h"
+#include "FlashLog.h"
+#include "TraceCapture.h"
+#include "misc/Clock.h"
+#include "misc/ChunkedResponse.h"
+#include "misc/TemplateRenderer.h"
+#include "misc/Lttb.h"
+#include "misc/Psychrometrics.h"
+#include "misc/TriggerPolicy.h"
 #include <sha256.h>
 
 const String versionString = "2.0.0";
+constexpr std::size_t MAX_HISTORY_POINTS = 300;
+constexpr std::size_t ROOT_HISTORY_POINTS = 60;
 
 static const char rootHtml[] PROGMEM =
   #include "www/index.html"
@@ -114,7 +125,11 @@ void handleClearHistory() {
   if (checkAuth() == false) {
     return;
   }
-  envLogic.measurements.clear();
+  envLogic.history.clear();
+  for(HumidityStats& s : envLogic.stats) {
+    s.clear();
+  }
+  flashLog.clear();
   httpServer.send(200, "text/plain", "200: OK");
 }
 
@@ -159,23 +174,39 @@ void handleNetConfig() {
   if (checkAuth() == false) {
     return;
   }
-  String html = FPSTR(netConfigHtml);
+  TemplateRenderer page;
 
   //network
-  html.replace("${ssid}", prefs.storage.ssid);
-  html.replace("${inNetworkName}", prefs.storage.inNetworkName);
-  html.replace("${username}", prefs.storage.username);
-  html.replace("${secureKey}", toHexString(prefs.storage.securityKey,
-      sizeof(prefs.storage.securityKey)));
+  page.add("ssid", [](Print& out) { out.print(prefs.storage.ssid); });
+  page.add("inNetworkName", [](Print& out) { out.print(prefs.storage.inNetworkName); });
+  page.add("username", [](Print& out) { out.print(prefs.storage.username); });
+  page.add("secureKey", [](Print& out) {
+    out.print(toHexString(prefs.storage.securityKey, sizeof(prefs.storage.securityKey)));
+  });
+
+  ChunkedResponse response(httpServer, 200, "text/html");
+  page.render(netConfigHtml, response);
+}
 
-  httpServer.send(200, "text/html", html);
+//stage names separated by comma, "none" for empty pipeline
+String getPipelineString() {
+  String names;
+  for(uint8_t type : prefs.storage.pipeline) {
+    const char* name = SignalPipeline::stageName(static_cast<Stage_t>(type));
+    if (name == nullptr) {
+      break;
+    }
+    names += names.length() > 0 ? "," : "";
+    names += name;
+  }
+  return names.length() > 0 ? names : String("none");
 }
 
 void handleGetConfig() {
   if (checkAuth() == false) {
     return;
   }
-  StaticJsonBuffer<400>  jsonBuffer;
+  StaticJsonBuffer<800>  jsonBuffer;
   JsonObject& root = jsonBuffer.createObject();
 
   //Network
@@ -194,6 +225,32 @@ void handleGetConfig() {
   root["timeToForget"] = prefs.storage.timeToForget;
   root["knownHumDiffTrigger"] = prefs.storage.knownHumDiffTrigger;
   root["humidityTrigger"] = prefs.storage.humidityTrigger;
+  root["triggerMode"] = prefs.storage.triggerMode;
+  root["absoluteTrigger"] = prefs.storage.absoluteTrigger;
+  root["dewPointSpread"] = prefs.storage.dewPointSpread;
+  root["holtAlpha"] = prefs.storage.holtAlpha;
+  root["holtBeta"] = prefs.storage.holtBeta;
+  root["holtHorizon"] = prefs.storage.holtHorizon;
+
+  //sampling
+  root["adaptiveSampling"] = prefs.storage.adaptiveSampling;
+  root["activeRate"] = prefs.storage.activeRate;
+  root["settleTime"] = prefs.storage.settleTime;
+
+  //filter
+  String pipeline = getPipelineString();
+  root["pipeline"] = pipeline;
+  root["medianSize"] = prefs.storage.medianSize;
+  root["deadband"] = prefs.storage.deadband;
+  root["rateLimit"] = prefs.storage.rateLimit;
+  root["kalmanQ"] = prefs.storage.kalmanQ;
+  root["kalmanR"] = prefs.storage.kalmanR;
+
+  //stats
+  JsonArray& windows = root.createNestedArray("statsWindow");
+  for(uint16_t window : prefs.storage.statsWindow) {
+    windows.add(window);
+  }
 
   String response;
   root.printTo(response);
@@ -228,6 +285,17 @@ int getIntArg(String argName, int maxValue, bool* isError) {
   return result;
 }
 
+//as above, value below minValue is rejected too
+int getIntArg(String argName, int minValue, int maxValue, bool* isError) {
+  int result = getIntArg(argName, maxValue, isError);
+  if ((not *isError) and httpServer.hasArg(argName) and (result < minValue)) {
+    String resp = "406: Not Acceptable, '" + argName + "' to small.";
+    httpServer.send(406, "text/plain", resp);
+    *isError = true;
+  }
+  return result;
+}
+
 bool emplaceChars(char* ptr, String argName, int maxLen) {
   bool fail;
   String tmp = getStringArg(argName, maxLen, &fail);
@@ -318,6 +386,15 @@ bool handleHeuristicConfig(SavedPrefs& p) {
   bool fail = true;
 
   p.humidityTrigger = getIntArg("humidityTrigger", 100, &fail);
+  if (not fail) {
+    p.triggerMode = getIntArg("triggerMode", TriggerMode_DEW_POINT + 1, &fail);
+  }
+  if (not fail) {
+    p.absoluteTrigger = getIntArg("absoluteTrigger", 255, &fail);
+  }
+  if (not fail) {
+    p.dewPointSpread = getIntArg("dewPointSpread", 255, &fail);
+  }
   if (not fail) {
     p.selectedHeuristic = getIntArg("selectedHeuristic", 255, &fail);
   }
@@ -328,7 +405,7 @@ bool handleHeuristicConfig(SavedPrefs& p) {
     p.disturberTriggerTime = getIntArg("disturberTriggerTime", 65535, &fail);
   }
   if (not fail) {
-    p.noSamples = getIntArg("noSamples", 120, &fail);
+    p.noSamples = getIntArg("noSamples", MAX_NO_SAMPLES, &fail);
   }
   if (not fail) {
     p.timeToForget = getIntArg("timeToForget", 65535, &fail);
@@ -336,6 +413,97 @@ bool handleHeuristicConfig(SavedPrefs& p) {
   if (not fail) {
     p.knownHumDiffTrigger = getIntArg("knownHumDiffTrigger", 100, &fail);
   }
+  if (not fail) {
+    p.holtAlpha = getIntArg("holtAlpha", 101, &fail);
+  }
+  if (not fail) {
+    p.holtBeta = getIntArg("holtBeta", 101, &fail);
+  }
+  if (not fail) {
+    p.holtHorizon = getIntArg("holtHorizon", 65535, &fail);
+  }
+
+  return fail;
+}
+
+//missing argument keeps current pipeline
+bool handlePipelineArg(SavedPrefs& p) {
+  bool fail;
+  memcpy(p.pipeline, prefs.storage.pipeline, sizeof(p.pipeline));
+  String names = getStringArg("pipeline", 64, &fail);
+  if (fail or (names.length() == 0)) {
+    return fail;
+  }
+
+  memset(p.pipeline, Stage_NONE, sizeof(p.pipeline));
+  if (names == "none") {
+    return false;
+  }
+  std::size_t count = 0;
+  uint8_t used = 0;
+  const char* name = names.c_str();
+  while (*name != 0) {
+    const char* end = strchr(name, ',');
+    std::size_t len = end != nullptr ? end - name : strlen(name);
+    Stage_t type = SignalPipeline::stageByName(name, len);
+    if ((type == Stage_NONE) or (count == SignalPipeline::MAX_STAGES)) {
+      httpServer.send(406, "text/plain", "406: Not Acceptable, 'pipeline' unknown stage or too many.");
+      return true;
+    }
+    //every stage has single state, assemble() would cut chain at repeated one
+    if (used & (1 << type)) {
+      httpServer.send(406, "text/plain", "406: Not Acceptable, 'pipeline' repeated stage.");
+      return true;
+    }
+    used |= 1 << type;
+    p.pipeline[count++] = type;
+    name += end != nullptr ? len + 1 : len;
+  }
+  return false;
+}
+
+bool handleSamplingConfig(SavedPrefs& p) {
+  bool fail;
+
+  //unchecked checkbox is not sent
+  p.adaptiveSampling = getIntArg("adaptiveSampling", 255, &fail) > 0 ? 1 : 0;
+  if (not fail) {
+    p.activeRate = getIntArg("activeRate", 255, &fail);
+  }
+  if (not fail) {
+    p.settleTime = getIntArg("settleTime", 65535, &fail);
+  }
+
+  return fail;
+}
+
+bool handleStatsConfig(SavedPrefs& p) {
+  bool fail = false;
+  //window of a week at most, bucket length in ms must fit 32 bits
+  for(std::size_t t = 0; (t < EnvLogic::STATS_COUNT) and (not fail); t++) {
+    p.statsWindow[t] = getIntArg("statsWindow" + String(t), 1, 7 * 24 * 60 + 1, &fail);
+  }
+  return fail;
+}
+
+bool handleFilterConfig(SavedPrefs& p) {
+  bool fail = handlePipelineArg(p);
+
+  if (not fail) {
+    p.medianSize = getIntArg("medianSize", SignalPipeline::MAX_MEDIAN + 1, &fail);
+  }
+  if (not fail) {
+    p.deadband = getIntArg("deadband", 255, &fail);
+  }
+  if (not fail) {
+    p.rateLimit = getIntArg("rateLimit", 255, &fail);
+  }
+  if (not fail) {
+    p.kalmanQ = getIntArg("kalmanQ", 1, 65535, &fail);
+  }
+  if (not fail) {
+    p.kalmanR = getIntArg("kalmanR", 1, 65535, &fail);
+  }
 
   return fail;
 }
@@ -408,6 +576,36 @@ void applyHeuristicConfig(SavedPrefs& p, bool& changed) {
   applyIfChanged(p.noSamples, prefs.storage.noSamples, changed);
   applyIfChanged(p.timeToForget, prefs.storage.timeToForget, changed);
   applyIfChanged(p.knownHumDiffTrigger, prefs.storage.knownHumDiffTrigger, changed);
+  applyIfChanged(p.holtAlpha, prefs.storage.holtAlpha, changed);
+  applyIfChanged(p.holtBeta, prefs.storage.holtBeta, changed);
+  applyIfChanged(p.holtHorizon, prefs.storage.holtHorizon, changed);
+  applyIfChanged(p.triggerMode, prefs.storage.triggerMode, changed);
+  applyIfChanged(p.absoluteTrigger, prefs.storage.absoluteTrigger, changed);
+  applyIfChanged(p.dewPointSpread, prefs.storage.dewPointSpread, changed);
+}
+
+void applySamplingConfig(SavedPrefs& p, bool& changed) {
+  applyIfChanged(p.adaptiveSampling, prefs.storage.adaptiveSampling, changed);
+  applyIfChanged(p.activeRate, prefs.storage.activeRate, changed);
+  applyIfChanged(p.settleTime, prefs.storage.settleTime, changed);
+}
+
+void applyStatsConfig(SavedPrefs& p, bool& changed) {
+  for(std::size_t t = 0; t < EnvLogic::STATS_COUNT; t++) {
+    applyIfChanged(p.statsWindow[t], prefs.storage.statsWindow[t], changed);
+  }
+}
+
+void applyFilterConfig(SavedPrefs& p, bool& changed) {
+  if (memcmp(p.pipeline, prefs.storage.pipeline, sizeof(p.pipeline)) != 0) {
+    memcpy(prefs.storage.pipeline, p.pipeline, sizeof(p.pipeline));
+    changed = true;
+  }
+  applyIfChanged(p.medianSize, prefs.storage.medianSize, changed);
+  applyIfChanged(p.deadband, prefs.storage.deadband, changed);
+  applyIfChanged(p.rateLimit, prefs.storage.rateLimit, changed);
+  applyIfChanged(p.kalmanQ, prefs.storage.kalmanQ, changed);
+  applyIfChanged(p.kalmanR, prefs.storage.kalmanR, changed);
 }
 
 bool applyPrefsChange(SavedPrefs& p, bool& restartNetwork) {
@@ -415,6 +613,9 @@ bool applyPrefsChange(SavedPrefs& p, bool& restartNetwork) {
   applyNetConfig(p, changed, restartNetwork);
   applyFanConfig(p, changed);
   applyHeuristicConfig(p, changed);
+  applySamplingConfig(p, changed);
+  applyFilterConfig(p, changed);
+  applyStatsConfig(p, changed);
 
   return changed | restartNetwork;
 }
@@ -429,6 +630,9 @@ void handleSetConfig() {
   bool fail = handleNetworkConfig(p);
   fail |= handleFanConfig(p);
   fail |= handleHeuristicConfig(p);
+  fail |= handleSamplingConfig(p);
+  fail |= handleFilterConfig(p);
+  fail |= handleStatsConfig(p);
 
   if (fail) {
     return;
@@ -474,23 +678,69 @@ void handleRun() {
   }
 }
 
-void getHistoryData(int count, String& labelData, String& humData) {
-  labelData = "";
-  humData = "";
-  auto m = envLogic.measurements.begin();
-  if ((unsigned int )count < envLogic.measurements.size()) {
-    m += envLogic.measurements.size() - count;
+//calls f for each of last count raw measurements
+template<typename F>
+void forLastMeasurements(std::size_t count, F f) {
+  const CompressedHistory& raw = envLogic.history.raw;
+  auto m = count < raw.size() ? raw.from(raw.size() - count) : raw.begin();
+  for(; m != raw.end(); m++) {
+    f(*m);
   }
-  long mil = millis();
-  for(; m != envLogic.measurements.end(); m++) {
-    labelData.concat("'");
-    labelData.concat( millisToTime(mil - m->timestamp) );
-    labelData.concat("',");
-    humData.concat( String(m->humidity) );
-    humData.concat(",");
+}
+
+//{x:-secondsAgo,<field>:value}, chart x axis is time relative to now
+void printChartPoint(Print& out, uint32_t now, uint32_t timestamp, const char* field, int value) {
+  out.print("{x:-");
+  out.print(now - timestamp);
+  out.print(",");
+  out.print(field);
+  out.print(":");
+  out.print(value);
+  out.print("}");
+}
+
+void printHistoryHumidity(Print& out) {
+  uint32_t now = systemClock.seconds();
+  const char* separator = "";
+  forLastMeasurements(ROOT_HISTORY_POINTS, [&](const Measurement& m) {
+    out.print(separator);
+    printChartPoint(out, now, m.timestamp, "y", m.humidity);
+    separator = ",";
+  });
+}
+
+//Decisions at start of charted humidity, then every change point from
+//decision ring, then current ones, so steps are drawn where they happened
+//and not only where humidity changed.
+void printHistoryShadow(Print& out) {
+  const History& history = envLogic.history;
+  const CompressedHistory& raw = history.raw;
+  uint32_t now = systemClock.seconds();
+  std::size_t first = raw.size() > ROOT_HISTORY_POINTS ? raw.size() - ROOT_HISTORY_POINTS : 0;
+  uint32_t from = raw.empty() ? now : raw.from(first)->timestamp;
+  printChartPoint(out, now, from, "b", history.getDecisions(from));
+  for(auto iter = history.decisionsAfter(from); iter != history.decisions.end(); ++iter) {
+    out.print(",");
+    printChartPoint(out, now, iter->timestamp, "b", iter->bits);
+  }
+  out.print(",");
+  printChartPoint(out, now, now, "b", envLogic.getDecisions());
+}
+
+//{id, name: "name (mean us)"} of every compiled in heuristic, for JS
+void printShadowHeuristics(Print& out) {
+  const char* separator = "";
+  for(const HeuristicInfo& info : HeuristicSet::REGISTERED) {
+    out.print(separator);
+    out.print("{id:");
+    out.print((int)info.id);
+    out.print(",name:'");
+    out.print(info.name);
+    out.print(" (");
+    out.print(envLogic.timings[info.id].getMean());
+    out.print(" us)'}");
+    separator = ",";
   }
-  labelData.remove(labelData.length() - 1);
-  humData.remove(labelData.length() - 1);
 }
 
 void handleRoot() {
@@ -498,12 +748,15 @@ void handleRoot() {
     return;
   }
   //put config inside
-  String html = FPSTR(rootHtml);
-  String labels, hums;
-  getHistoryData(60, labels, hums);
-  html.replace("${dataLabels}", labels);
-  html.replace("${dataHum}", hums);
-  httpServer.send(200, "text/html", html);
+  TemplateRenderer page;
+  page.add("dataHum", printHistoryHumidity);
+  page.add("dataShadow", printHistoryShadow);
+  page.add("shadowHeuristics", printShadowHeuristics);
+  page.add("selectedHeuristic", [](Print& out) { out.print((int)envLogic.getSelectedHeuristic()); });
+  {
+    ChunkedResponse response(httpServer, 200, "text/html");
+    page.render(rootHtml, response);
+  }
   delay(100);
   httpServer.client().stop();
 }
@@ -512,25 +765,59 @@ void handleSetup() {
   if (checkAuth() == false) {
     return;
   }
-  String html = FPSTR(setupHtml);
+  TemplateRenderer page;
 
   //fan
-  html.replace("${muteFanOff}", String(prefs.storage.muteFanOff));
-  html.replace("${muteFanOn}", String(prefs.storage.muteFanOn));
+  page.add("muteFanOff", [](Print& out) { out.print(prefs.storage.muteFanOff); });
+  page.add("muteFanOn", [](Print& out) { out.print(prefs.storage.muteFanOn); });
 
   //heuristic
-  html.replace("${humidityTrigger}", String(prefs.storage.humidityTrigger));
-  html.replace("${disturberTriggerTime}", String(prefs.storage.disturberTriggerTime));
-  html.replace("${noSamples}", String(prefs.storage.noSamples));
-  html.replace("${timeToForget}", String(prefs.storage.timeToForget));
-  html.replace("${knownHumDiffTrigger}", String(prefs.storage.knownHumDiffTrigger));
+  page.add("humidityTrigger", [](Print& out) { out.print((int)prefs.storage.humidityTrigger); });
+  page.add("disturberTriggerTime", [](Print& out) { out.print(prefs.storage.disturberTriggerTime); });
+  page.add("noSamples", [](Print& out) { out.print(prefs.storage.noSamples); });
+  page.add("timeToForget", [](Print& out) { out.print(prefs.storage.timeToForget); });
+  page.add("knownHumDiffTrigger", [](Print& out) { out.print(prefs.storage.knownHumDiffTrigger); });
+  page.add("holtAlpha", [](Print& out) { out.print(prefs.storage.holtAlpha); });
+  page.add("holtBeta", [](Print& out) { out.print(prefs.storage.holtBeta); });
+  page.add("holtHorizon", [](Print& out) { out.print(prefs.storage.holtHorizon); });
+  page.add("absoluteTrigger", [](Print& out) { out.print(prefs.storage.absoluteTrigger); });
+  page.add("dewPointSpread", [](Print& out) { out.print(prefs.storage.dewPointSpread); });
+  page.add("triggerMode", [](Print& out) {
+    out.print("trigger");
+    out.print(prefs.storage.triggerMode);
+  });
+
+  //sampling
+  page.add("adaptiveSampling_defVal", [](Print& out) {
+    out.print(prefs.storage.adaptiveSampling != 0 ? "checked" : " ");
+  });
+  page.add("activeRate", [](Print& out) { out.print(prefs.storage.activeRate); });
+  page.add("settleTime", [](Print& out) { out.print(prefs.storage.settleTime); });
+
+  //filter
+  page.add("pipeline", [](Print& out) { out.print(getPipelineString()); });
+  page.add("medianSize", [](Print& out) { out.print(prefs.storage.medianSize); });
+  page.add("deadband", [](Print& out) { out.print(prefs.storage.deadband); });
+  page.add("rateLimit", [](Print& out) { out.print(prefs.storage.rateLimit); });
+  page.add("kalmanQ", [](Print& out) { out.print(prefs.storage.kalmanQ); });
+  page.add("kalmanR", [](Print& out) { out.print(prefs.storage.kalmanR); });
+  //stats
+  page.add("statsWindow0", [](Print& out) { out.print(prefs.storage.statsWindow[0]); });
+  page.add("statsWindow1", [](Print& out) { out.print(prefs.storage.statsWindow[1]); });
+  page.add("statsWindow2", [](Print& out) { out.print(prefs.storage.statsWindow[2]); });
   //checkbox values
-  html.replace("${useDisturber_defVal}", prefs.storage.useDisturber != 0 ? "checked":" ");
-  String heur("heur");
-  heur += prefs.storage.selectedHeuristic;
-  html.replace("${selectedHeuristic}", heur);
-
-  httpServer.send(200, "text/html", html);
+  page.add("useDisturber_defVal", [](Print& out) {
+    out.print(prefs.storage.useDisturber != 0 ? "checked" : " ");
+  });
+  page.add("selectedHeuristic", [](Print& out) {
+    out.print("heur");
+    out.print(prefs.storage.selectedHeuristic);
+  });
+
+  {
+    ChunkedResponse response(httpServer, 200, "text/html");
+    page.render(setupHtml, response);
+  }
   delay(100);
   httpServer.client().stop();
 }
@@ -552,20 +839,331 @@ void handleUpdate() {
   httpServer.client().stop();
 }
 
+template<std::size_t N>
+void sendRollupHistory(const RollupTier<N>& tier, uint32_t from, uint32_t to) {
+  //buckets are consecutive so only first timestamp is sent, each item is
+  //[min,avg,max] or null when bucket got no samples
+  const uint32_t period = tier.getPeriod();
+  const uint32_t start = tier.getTimestamp(0);
+  std::size_t first = from > start ? (from - start + period - 1) / period : 0;
+  std::size_t last = to >= start ? (to - start) / period + 1 : 0;
+  last = last > tier.items.size() ? tier.items.size() : last;
+  first = first > last ? last : first;
+
+  ChunkedResponse response(httpServer, 200, "application/json");
+  response.print("{\"now\":");
+  response.print(systemClock.seconds());
+  response.print(",\"bootEpoch\":");
+  response.print(systemClock.getBootEpoch());
+  response.print(",\"period\":");
+  response.print(tier.getPeriod());
+  response.print(",\"start\":");
+  response.print(tier.getTimestamp(first));
+  response.print(",\"items\":[");
+  for(std::size_t t = first; t < last; t++) {
+    const Rollup& r = tier.items[t];
+    if (t > first) {
+      response.print(",");
+    }
+    if (r.isEmpty()) {
+      response.print("null");
+      continue;
+    }
+    response.print("[");
+    response.print((int)r.min);
+    response.print(",");
+    response.print((int)r.avg);
+    response.print(",");
+    response.print((int)r.max);
+    response.print("]");
+  }
+  response.print("]}");
+}
+
+void sendRawHistory(uint32_t from, uint32_t to, std::size_t points) {
+  const CompressedHistory& raw = envLogic.history.raw;
+  CompressedHistory::const_iterator first = raw.lowerBound(from);
+  std::size_t count = 0;
+  for(auto iter = first; (iter != raw.end()) and (iter->timestamp <= to); ++iter) {
+    count++;
+  }
+  const uint32_t origin = count > 0 ? first->timestamp : 0;
+
+  ChunkedResponse response(httpServer, 200, "application/json");
+  response.print("{\"now\":");
+  response.print(systemClock.seconds());
+  response.print(",\"bootEpoch\":");
+  response.print(systemClock.getBootEpoch());
+  response.print(",\"items\":[");
+  const char* separator = "";
+  lttb(first, count, points,
+      [origin](const Measurement& m) { return (float)(m.timestamp - origin); },
+      [](const Measurement& m) { return (float)m.humidity; },
+      [&response, &separator](const Measurement& m) {
+        response.print(separator);
+        response.print("{\"H\":");
+        response.print((int)m.humidity);
+        if (m.temperature != Measurement::NO_TEMPERATURE) {
+          response.print(",\"T\":");
+          response.print((int)m.temperature);
+        }
+        response.print(",\"D\":");
+        response.print(m.timestamp);
+        response.print("}");
+        separator = ",";
+      });
+  response.print("]}");
+}
+
+void sendFlashIndex() {
+  DynamicJsonBuffer  jsonBuffer;
+  JsonObject& root = jsonBuffer.createObject();
+  root["now"] = systemClock.seconds();
+  root["boot"] = flashLog.getBoot();
+  JsonArray& items = root.createNestedArray("segments");
+  for(const FlashLog::SegmentInfo& info : flashLog.segments) {
+    JsonObject& item = jsonBuffer.createObject();
+    item["seq"] = info.seq;
+    item["boot"] = info.boot;
+    item["bootEpoch"] = info.bootEpoch;
+    item["count"] = info.count;
+    item["from"] = info.first;
+    item["to"] = info.last;
+    items.add(item);
+  }
+  String response;
+  root.printTo(response);
+  httpServer.send(200, "application/json", response);
+}
+
+void sendFlashSegment(uint32_t seq) {
+  //status has to be known before streaming starts
+  bool known = false;
+  for(const FlashLog::SegmentInfo& info : flashLog.segments) {
+    known |= info.seq == seq;
+  }
+  if (not known) {
+    httpServer.send(404, "text/plain", "404: Not found");
+    return;
+  }
+
+  //each item is [D,H] or [D,H,T] when temperature was measured
+  ChunkedResponse response(httpServer, 200, "application/json");
+  response.print("{\"seq\":");
+  response.print(seq);
+  response.print(",\"items\":[");
+  const char* separator = "";
+  flashLog.read(seq, [&response, &separator](const Measurement& m) {
+    response.print(separator);
+    response.print("[");
+    response.print(m.timestamp);
+    response.print(",");
+    response.print((int)m.humidity);
+    if (m.temperature != Measurement::NO_TEMPERATURE) {
+      response.print(",");
+      response.print((int)m.temperature);
+    }
+    response.print("]");
+    separator = ",";
+  });
+  response.print("]}");
+}
+
+void sendCaptureStatus() {
+  StaticJsonBuffer<200> jsonBuffer;
+  JsonObject& root = jsonBuffer.createObject();
+  root["active"] = traceCapture.isActive();
+  root["remaining"] = traceCapture.getRemaining();
+  root["records"] = traceCapture.getRecords();
+  root["bytes"] = traceCapture.getBytes();
+  String response;
+  root.printTo(response);
+  httpServer.send(200, "application/json", response);
+}
+
+void handleCapture() {
+  if (checkAuth() == false) {
+    return;
+  }
+  if (not httpServer.hasArg("download")) {
+    sendCaptureStatus();
+    return;
+  }
+  traceCapture.flush();
+  File file = LittleFS.open(TraceCapture::PATH, "r");
+  if (not file) {
+    httpServer.send(404, "text/plain", "404: Not found");
+    return;
+  }
+  httpServer.streamFile(file, "application/octet-stream");
+  file.close();
+}
+
+void handleCaptureControl() {
+  if (checkAuth() == false) {
+    return;
+  }
+  bool fail = false;
+  int duration = getIntArg("duration", TraceCapture::MAX_DURATION + 1, &fail);
+  if (fail) {
+    return;
+  }
+  if (duration < 0) {
+    httpServer.send(400, "text/plain", "400: BAD REQUEST");
+    return;
+  }
+  if (duration == 0) {
+    traceCapture.stop();
+
+  } else if (not traceCapture.start(duration)) {
+    httpServer.send(507, "text/plain", "507: Insufficient Storage");
+    return;
+  }
+  sendCaptureStatus();
+}
+
 void handleHistory() {
+  if (checkAuth() == false) {
+    return;
+  }
+  String resolution = httpServer.arg("resolution");
+  uint32_t from = httpServer.hasArg("from") ? httpServer.arg("from").toInt() : 0;
+  uint32_t to = httpServer.hasArg("to") ? httpServer.arg("to").toInt() : UINT32_MAX;
+  std::size_t points = MAX_HISTORY_POINTS;
+  if (httpServer.hasArg("points")) {
+    points = httpServer.arg("points").toInt();
+    points = (points == 0) or (points > MAX_HISTORY_POINTS) ? MAX_HISTORY_POINTS : points;
+  }
+
+  if (resolution == "minute") {
+    sendRollupHistory(envLogic.history.minutes, from, to);
+
+  } else if (resolution == "hour") {
+    sendRollupHistory(envLogic.history.hours, from, to);
+
+  } else if (resolution == "flash") {
+    //not flushed samples are still in envLogic.history.raw
+    if (httpServer.hasArg("segment")) {
+      sendFlashSegment(httpServer.arg("segment").toInt());
+    } else {
+      sendFlashIndex();
+    }
+
+  } else {
+    sendRawHistory(from, to, points);
+  }
+  delay(100);
+  httpServer.client().stop();
+}
+
+void handleStats() {
   if (checkAuth() == false) {
     return;
   }
   DynamicJsonBuffer  jsonBuffer;
   JsonObject& root = jsonBuffer.createObject();
-  JsonArray& items = root.createNestedArray("items");
-  root["now"] = millis();
-  for(auto iter = envLogic.measurements.begin(); iter != envLogic.measurements.end(); iter++) {
+  root["now"] = systemClock.seconds();
+  root["trigger"] = triggerPolicy.getRelativeTrigger().toFloat();
+  JsonArray& items = root.createNestedArray("windows");
+  for(const HumidityStats& s : envLogic.stats) {
     JsonObject& item = jsonBuffer.createObject();
-    item["H"] = iter->humidity;
-    item["D"] = iter->timestamp;
+    item["window"] = s.getWindow();
+    item["covered"] = s.getCovered();
+    if (not s.isEmpty()) {
+      item["mean"] = s.getMean().toFloat();
+      item["stdDev"] = s.getStdDev().toFloat();
+      item["min"] = s.getMin().toFloat();
+      item["max"] = s.getMax().toFloat();
+      item["above"] = s.getTimeAbove();
+    }
     items.add(item);
   }
+  JsonArray& heuristics = root.createNestedArray("heuristics");
+  for(const HeuristicInfo& info : HeuristicSet::REGISTERED) {
+    const HeuristicTiming& timing = envLogic.timings[info.id];
+    JsonObject& item = jsonBuffer.createObject();
+    item["id"] = info.id;
+    item["name"] = info.name;
+    item["selected"] = info.id == envLogic.getSelectedHeuristic();
+    item["fan"] = (envLogic.getDecisions() & (1 << info.id)) != 0;
+    item["meanMicros"] = timing.getMean();
+    item["maxMicros"] = timing.maxMicros;
+    heuristics.add(item);
+  }
+  const TickScheduler& ticker = envLogic.controlTicker;
+  JsonObject& tick = root.createNestedObject("tick");
+  tick["period"] = ticker.getPeriod();
+  tick["ticks"] = ticker.getTicks();
+  tick["jitter"] = ticker.getLastJitter();
+  tick["meanJitter"] = ticker.getMeanJitter();
+  tick["maxJitter"] = ticker.getMaxJitter();
+  tick["overruns"] = ticker.getOverruns();
+  tick["dropped"] = ticker.getDropped();
+  const SHT21& sht = envLogic.getSensor();
+  JsonObject& sensor = root.createNestedObject("sensor");
+  sensor["crcErrors"] = sht.getCrcErrors();
+  sensor["timeouts"] = sht.getTimeouts();
+  sensor["retries"] = envLogic.sensorHealth.retries;
+  sensor["failures"] = envLogic.sensorHealth.failures;
+  if (envLogic.getTemperature() != Measurement::NO_TEMPERATURE) {
+    Fixed humidity = envLogic.getHumidity();
+    Fixed temperature = envLogic.getTemperature();
+    sensor["temperature"] = envLogic.getTemperature();
+    sensor["absolute"] = Psychrometrics::absoluteHumidity(humidity, temperature).toFloat();
+    sensor["dewPoint"] = Psychrometrics::dewPoint(humidity, temperature).toFloat();
+  }
+  const AdaptiveSampler& sampler = envLogic.sampler;
+  JsonObject& sampling = root.createNestedObject("sampling");
+  sampling["interval"] = sampler.getInterval();
+  sampling["rate"] = sampler.getRate().toFloat();
+  sampling["fast"] = sampler.getSamples(SamplingMode_FAST);
+  sampling["normal"] = sampler.getSamples(SamplingMode_NORMAL);
+  sampling["slow"] = sampler.getSamples(SamplingMode_SLOW);
+  const SignalPipeline& pipeline = envLogic.pipeline;
+  JsonObject& signal = root.createNestedObject("pipeline");
+  signal["raw"] = pipeline.getInput().toFloat();
+  JsonArray& stages = signal.createNestedArray("stages");
+  for (std::size_t i = 0; i < pipeline.size(); i++) {
+    JsonObject& item = jsonBuffer.createObject();
+    item["name"] = SignalPipeline::stageName(pipeline.getStage(i));
+    item["output"] = pipeline.getOutput(i).toFloat();
+    stages.add(item);
+  }
+  String response;
+  root.printTo(response);
+  httpServer.send(200, "application/json", response);
+  delay(100);
+  httpServer.client().stop();
+}
+
+void handleFanEvents() {
+  if (checkAuth() == false) {
+    return;
+  }
+  DynamicJsonBuffer  jsonBuffer;
+  JsonObject& root = jsonBuffer.createObject();
+  root["now"] = systemClock.seconds();
+  root["running"] = envLogic.isFanRunning();
+  root["total"] = fanLog.getTotalRuntime();
+  root["switches"] = fanLog.getSwitchCount();
+  root["currentHour"] = fanLog.getCurrentHour();
+  root["currentDay"] = fanLog.getCurrentDay();
+  JsonArray& hours = root.createNestedArray("hours");
+  for(uint16_t sec : fanLog.hours) {
+    hours.add(sec);
+  }
+  JsonArray& days = root.createNestedArray("days");
+  for(uint32_t sec : fanLog.days) {
+    days.add(sec);
+  }
+  JsonArray& events = root.createNestedArray("events");
+  for(const FanEvent& e : fanLog.events) {
+    JsonObject& item = jsonBuffer.createObject();
+    item["D"] = e.timestamp;
+    item["on"] = e.isOn();
+    item["cause"] = fanCauseName(e.getCause());
+    events.add(item);
+  }
   String response;
   root.printTo(response);
   httpServer.send(200, "application/json", response);
@@ -577,7 +1175,7 @@ void handleStatus() {
   if (checkExtAuth() == false) {
     return;
   }
-  StaticJsonBuffer<50>  jsonBuffer;
+  StaticJsonBuffer<80>  jsonBuffer;
   JsonObject& root = jsonBuffer.createObject();
   if (httpServer.hasArg("Simplified")) {
     root["l1"] = "Wilgotnosc:";
@@ -585,7 +1183,10 @@ void handleStatus() {
 
   } else {
     root["H"] = envLogic.getHumidity();
-    root["D"] = millis();
+    root["D"] = systemClock.seconds();
+    if (envLogic.getTemperature() != Measurement::NO_TEMPERATURE) {
+      root["T"] = envLogic.getTemperature();
+    }
   }
   String response;
   root.printTo(response);
@@ -604,6 +1205,10 @@ MyServer::MyServer() : needsConfig(true) {
   httpServer.on("/config", HTTP_POST, handleSetConfig);
   httpServer.on("/status", handleStatus);
   httpServer.on("/history", handleHistory);
+  httpServer.on("/capture", HTTP_GET, handleCapture);
+  httpServer.on("/capture", HTTP_POST, handleCaptureControl);
+  httpServer.on("/stats", HTTP_GET, handleStats);
+  httpServer.on("/fan/events", HTTP_GET, handleFanEvents);
   httpServer.on("/run", HTTP_POST, handleRun);
   httpServer.on("/clearHistory", handleClearHistory);
   httpServer.on("/update", HTTP_POST, handleUpdate);
@@ -0,0 +1,146 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TraceCapture.cpp
+ Created on: Oct 17, 2026
+ */
+#include "TraceCapture.h"
+#include <LittleFS.h>
+#include "EnvLogic.h"
+#include "misc/AdaptiveSampler.h"
+#include "misc/Clock.h"
+
+TraceCapture traceCapture;
+
+namespace {
+  //capture keeps fast sampling, temperature is read on its own interval
+  constexpr uint32_t RECORDS_PER_MINUTE = 60000 / AdaptiveSampler::INTERVALS[SamplingMode_FAST] +
+      60000 / EnvLogic::TEMPERATURE_INTERVAL;
+  //LittleFS metadata and space left for flash log
+  constexpr uint32_t RESERVED_BYTES = 16 * 1024;
+}
+
+bool TraceCapture::start(uint32_t seconds) {
+  stop();
+  FSInfo info;
+  if ((not LittleFS.info(info)) or (seconds == 0) or (seconds > MAX_DURATION)) {
+    return false;
+  }
+  //old capture is replaced, so its space counts as free
+  File old = LittleFS.open(PATH, "r");
+  uint32_t freeBytes = info.totalBytes - info.usedBytes + (old ? old.size() : 0);
+  old.close();
+  uint32_t needed = sizeof(Header) + (seconds * RECORDS_PER_MINUTE + 59) / 60 * sizeof(Record);
+  if (needed + RESERVED_BYTES > freeBytes) {
+    return false;
+  }
+
+  File file = LittleFS.open(PATH, "w");
+  if (not file) {
+    return false;
+  }
+  Header header = {MAGIC, systemClock.getBootEpoch(), systemClock.seconds(), sizeof(Record)};
+  file.write((uint8_t*)&header, sizeof(header));
+  file.close();
+
+  active = true;
+  records = 0;
+  bufferCount = 0;
+  lastRecord = systemClock.now();
+  endTime = lastRecord + seconds * 1000ULL;
+  Serial.print("TraceCapture: started for ");
+  Serial.println(seconds);
+  return true;
+}
+
+void TraceCapture::stop() {
+  if (not active) {
+    return;
+  }
+  flush();
+  active = false;
+  Serial.print("TraceCapture: stopped, records ");
+  Serial.println(records);
+}
+
+void TraceCapture::add(uint16_t raw, bool isTemperature, Fixed filtered, bool fanRunning) {
+  if (not active) {
+    return;
+  }
+  uint64_t now = systemClock.now();
+  uint64_t dt = now - lastRecord;
+  lastRecord = now;
+
+  Record& rec = buffer[bufferCount++];
+  rec.dt = dt > UINT16_MAX ? UINT16_MAX : dt;
+  rec.raw = raw;
+  rec.filtered = (filtered * 100).toInt();
+  rec.flags = (fanRunning ? FLAG_FAN : 0) | (isTemperature ? FLAG_TEMPERATURE : 0);
+  records++;
+  if (bufferCount == BUFFER_COUNT) {
+    flush();
+  }
+}
+
+void TraceCapture::update() {
+  if (active and (systemClock.now() >= endTime)) {
+    stop();
+  }
+}
+
+void TraceCapture::flush() {
+  if (bufferCount == 0) {
+    return;
+  }
+  File file = LittleFS.open(PATH, "a");
+  if (file) {
+    file.write((uint8_t*)buffer, bufferCount * sizeof(Record));
+    file.close();
+  }
+  bufferCount = 0;
+}
+
+bool TraceCapture::isActive() const {
+  return active;
+}
+
+uint32_t TraceCapture::getRemaining() const {
+  uint64_t now = systemClock.now();
+  return active and (endTime > now) ? (endTime - now + 999) / 1000 : 0;
+}
+
+uint32_t TraceCapture::getRecords() const {
+  return records;
+}
+
+uint32_t TraceCapture::getBytes() const {
+  return records > 0 ? sizeof(Header) + records * sizeof(Record) : 0;
+}
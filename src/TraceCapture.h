@@ -0,0 +1,98 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TraceCapture.h
+ Created on: Oct 17, 2026
+ */
+#ifndef TraceCapture_hpp
+#define TraceCapture_hpp
+
+#include <Arduino.h>
+#include "misc/Fixed.h"
+
+//Records every sensor reading for limited time, so filters and heuristics
+//can be tuned offline with tools/host/replay. Records are collected in RAM
+//and appended to single file on LittleFS, previous capture is overwritten.
+//
+//File is Header followed by Records, all little endian:
+//  Header  "HCP1", bootEpoch u32, start u32 (seconds since boot), recordSize u8
+//  Record  dt u16 (ms since previous record), raw u16 (SHT21 word, status bits
+//          cleared), filtered i16 (pipeline output in 0.01 %), flags u8
+class TraceCapture {
+  public:
+    static constexpr uint32_t MAX_DURATION = 60 * 60;
+    static constexpr std::size_t BUFFER_COUNT = 64;
+    static constexpr const char* PATH = "/capture.bin";
+    static constexpr uint32_t MAGIC = 0x48435031;  //"HCP1"
+    static constexpr uint8_t FLAG_FAN = 0x01;
+    static constexpr uint8_t FLAG_TEMPERATURE = 0x02;  //raw is temperature word
+
+    struct __attribute__ ((packed)) Header {
+      uint32_t magic;
+      uint32_t bootEpoch;
+      uint32_t start;
+      uint8_t recordSize;
+    };
+
+    struct __attribute__ ((packed)) Record {
+      uint16_t dt;
+      uint16_t raw;
+      int16_t filtered;
+      uint8_t flags;
+    };
+
+    //false when filesystem is missing or too small for duration
+    bool start(uint32_t seconds);
+    void stop();
+    void add(uint16_t raw, bool isTemperature, Fixed filtered, bool fanRunning);
+    //stops capture when its time is over
+    void update();
+    //writes buffered records, so file can be downloaded during capture
+    void flush();
+
+    bool isActive() const;
+    //seconds until capture stops
+    uint32_t getRemaining() const;
+    uint32_t getRecords() const;
+    //size of file with records still in buffer
+    uint32_t getBytes() const;
+  private:
+    bool active = false;
+    uint64_t endTime = 0;
+    uint64_t lastRecord = 0;
+    uint32_t records = 0;
+    Record buffer[BUFFER_COUNT];
+    std::size_t bufferCount = 0;
+};
+
+extern TraceCapture traceCapture;
+
+#endif /* TraceCapture_hpp */
@@ -36,6 +36,7 @@
 #include <Arduino.h>
 #include <SSD1306.h>
 #include "Updater.h"
+#include "FlashLog.h"
 
 extern SSD1306  display;
 Updater updater;
@@ -46,6 +47,7 @@ Updater::Updater(): delayTimer(0), lastMs(0), screen(UpdaterScreen_NONE) {
 
 void Updater::execute(String url) {
   showUpdateInfo();
+  flashLog.flush();
   ESPhttpUpdate.rebootOnUpdate(true);
   t_httpUpdate_return ret = ESPhttpUpdate.update(url);
   handleUpdateError(ret);
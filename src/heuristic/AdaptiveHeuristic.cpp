@@ -36,23 +36,16 @@
 
 #include "AdaptiveHeuristic.h"
 #include "misc/Prefs.h"
-#include <numeric>
-#include <algorithm>
 
 AdaptiveHeuristic::AdaptiveHeuristic(Fan &fan) : Heuristic(fan), disturber(Disturber(fan)) {}
 
 void AdaptiveHeuristic::update(int humidity) {
-  samples.push_back(humidity);
-
-  if (samples.size() == prefs.storage.noSamples) {
-    double mean, stdDev;
-    calcMeanAndStdDev(mean, stdDev);
-
-    fan.shouldRun = significantMeanChange(mean, stdDev);
-    baseMean = mean;
-    baseStdDev = stdDev;
-
-    samples.clear();
+  batch.setLength(prefs.storage.noSamples);
+  //compare each complete batch with previous one
+  if (batch.add(humidity)) {
+    fan.shouldRun = significantMeanChange(batch.getMean(), baseMean, baseStdDev);
+    baseMean = batch.getMean();
+    baseStdDev = batch.getStdDev();
   }
 
   //random environment trigger changer
@@ -61,18 +54,7 @@ void AdaptiveHeuristic::update(int humidity) {
   }
 }
 
-void AdaptiveHeuristic::calcMeanAndStdDev(double &mean, double &stdev) {
-  mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
-
-  double accum = 0.0;
-  for(auto i = samples.begin(); i != samples.end(); i++) {
-    accum += (*i - mean) * (*i - mean);
-  };
-
-  stdev = sqrt(accum / (samples.size()-1));
-}
-
-bool AdaptiveHeuristic::significantMeanChange(double mean, double stdDev) {
-  double ss = baseStdDev < 0.1 ? baseMean / 12 : baseStdDev;
-  return (abs(mean - baseMean) > 2 * ss);
+bool AdaptiveHeuristic::significantMeanChange(Fixed mean, Fixed baseMean, Fixed baseStdDev) {
+  Fixed ss = baseStdDev < Fixed::ratio(1, 10) ? baseMean / 12 : baseStdDev;
+  return (Fixed::abs(mean - baseMean) > ss * 2);
 }
@@ -40,22 +40,22 @@
 
 #include "Heuristic.h"
 #include "Disturber.h"
-#include <vector>
+#include "misc/SampleWindow.h"
 
 class AdaptiveHeuristic : public Heuristic {
   public:
     AdaptiveHeuristic(Fan &fan);
 
-    void update(int humidity) override;
+    void update(int humidity);
   private:
-    double baseMean = 0;
-    double baseStdDev = 0;
-    std::vector<int8_t> samples;
+    //batch of noSamples readings, decision is made when it is complete
+    SampleWindow<MAX_NO_SAMPLES> batch{WindowMode_TUMBLING, MAX_NO_SAMPLES};
+    //previous complete batch
+    Fixed baseMean;
+    Fixed baseStdDev;
     Disturber disturber;
 
-    void calcMeanAndStdDev(double &mean, double &dev);
-    bool significantDiff(double dev, double stdDev);
-    bool significantMeanChange(double mean, double stdDev);
+    bool significantMeanChange(Fixed mean, Fixed baseMean, Fixed baseStdDev);
 };
 
 
@@ -36,23 +36,16 @@
 
 #include "AdaptiveHeuristic2.h"
 #include "misc/Prefs.h"
-#include <numeric>
-#include <algorithm>
 
 AdaptiveHeuristic2::AdaptiveHeuristic2(Fan &fan) : Heuristic(fan), disturber(Disturber(fan)) {}
 
 void AdaptiveHeuristic2::update(int humidity) {
-  samples.push_back(humidity);
-
-  if (samples.size() == prefs.storage.noSamples) {
-    double mean, stdDev;
-    calcMeanAndStdDev(mean, stdDev);
-
-    fan.shouldRun = significantDiff(mean, baseMean);// or significantDiff(stdDev, baseStdDev);
-    baseMean = mean;
-    baseStdDev = stdDev;
-
-    samples.clear();
+  batch.setLength(prefs.storage.noSamples);
+  //compare each complete batch with previous one
+  if (batch.add(humidity)) {
+    fan.shouldRun = significantDiff(batch.getMean(), baseMean);
+    baseMean = batch.getMean();
+    baseStdDev = batch.getStdDev();
   }
 
   //random environment trigger changer
@@ -61,20 +54,9 @@ void AdaptiveHeuristic2::update(int humidity) {
   }
 }
 
-void AdaptiveHeuristic2::calcMeanAndStdDev(double &mean, double &stdev) {
-  mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
-
-  double accum = 0.0;
-  for(auto i = samples.begin(); i != samples.end(); i++) {
-    accum += (*i - mean) * (*i - mean);
-  };
-
-  stdev = sqrt(accum / (samples.size()-1));
-}
-
-bool AdaptiveHeuristic2::significantDiff(double val1, double val2) {
-  val1 = val1 == 0 ? 1 : val1;
+bool AdaptiveHeuristic2::significantDiff(Fixed val1, Fixed val2) {
+  val1 = val1 == 0 ? Fixed(1) : val1;
   val1 = (val2 * 100 / val1);
-  val1 = abs(val1 - 100);
+  val1 = Fixed::abs(val1 - 100);
   return val1 > 3;
 }
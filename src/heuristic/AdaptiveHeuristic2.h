@@ -39,21 +39,22 @@
 
 #include "Heuristic.h"
 #include "Disturber.h"
-#include <vector>
+#include "misc/SampleWindow.h"
 
 class AdaptiveHeuristic2: public Heuristic {
 public:
     AdaptiveHeuristic2(Fan &fan);
 
-    void update(int humidity) override;
+    void update(int humidity);
   private:
-    double baseMean = 0;
-    double baseStdDev = 0;
-    std::vector<int8_t> samples;
+    //batch of noSamples readings, decision is made when it is complete
+    SampleWindow<MAX_NO_SAMPLES> batch{WindowMode_TUMBLING, MAX_NO_SAMPLES};
+    //previous complete batch
+    Fixed baseMean;
+    Fixed baseStdDev;
     Disturber disturber;
 
-    void calcMeanAndStdDev(double &mean, double &dev);
-    bool significantDiff(double dev, double stdDev);
+    bool significantDiff(Fixed val1, Fixed val2);
 };
 
 #endif /* SRC_ADAPTIVEHEURISTIC2_H_ */
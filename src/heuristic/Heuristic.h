@@ -38,11 +38,14 @@
 
 #include "periphery/Fan.h"
 
+//upper limit of prefs.storage.noSamples
+constexpr std::size_t MAX_NO_SAMPLES = 120;
+
+//Base of all strategies, every subclass provides void update(int humidity)
+//called once per control tick. Dispatch is done by HeuristicSet, no vtable.
 class Heuristic {
   public:
     Heuristic(Fan& fan) : fan(fan) {}
-    virtual ~Heuristic() = default;
-    virtual void update(int humidity) = 0;
   protected:
     Fan& fan;
 };
@@ -0,0 +1,103 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ HeuristicSet.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "heuristic/HeuristicSet.h"
+
+constexpr HeuristicInfo HeuristicSet::REGISTERED[];
+
+HeuristicSet::HeuristicSet(CompressedHistory& history) :
+    fans{Fan(Fan::NO_PIN), Fan(Fan::NO_PIN), Fan(Fan::NO_PIN), Fan(Fan::NO_PIN), Fan(Fan::NO_PIN),
+        Fan(Fan::NO_PIN)}
+#if WITH_LIMITER_HEURISTIC
+    , limiter(fans[HeuristicId_LIMITER])
+#endif
+#if WITH_ADAPTIVE_HEURISTIC
+    , adaptive(fans[HeuristicId_ADAPTIVE])
+#endif
+#if WITH_ADAPTIVE2_HEURISTIC
+    , adaptive2(fans[HeuristicId_ADAPTIVE2])
+#endif
+#if WITH_NICETOHAVE_HEURISTIC
+    , niceToHave(fans[HeuristicId_NICETOHAVE])
+#endif
+#if WITH_LINEAR_HEURISTIC
+    , linear(fans[HeuristicId_LINEAR], history)
+#endif
+#if WITH_HOLT_HEURISTIC
+    , holt(fans[HeuristicId_HOLT])
+#endif
+{
+}
+
+Fan& HeuristicSet::getFan(HeuristicId_t id) {
+  return fans[id];
+}
+
+void HeuristicSet::update(HeuristicId_t id, int humidity) {
+  switch(id) {
+#if WITH_LIMITER_HEURISTIC
+    case HeuristicId_LIMITER:
+      limiter.update(humidity);
+      break;
+#endif
+#if WITH_ADAPTIVE_HEURISTIC
+    case HeuristicId_ADAPTIVE:
+      adaptive.update(humidity);
+      break;
+#endif
+#if WITH_ADAPTIVE2_HEURISTIC
+    case HeuristicId_ADAPTIVE2:
+      adaptive2.update(humidity);
+      break;
+#endif
+#if WITH_NICETOHAVE_HEURISTIC
+    case HeuristicId_NICETOHAVE:
+      niceToHave.update(humidity);
+      break;
+#endif
+#if WITH_LINEAR_HEURISTIC
+    case HeuristicId_LINEAR:
+      linear.update(humidity);
+      break;
+#endif
+#if WITH_HOLT_HEURISTIC
+    case HeuristicId_HOLT:
+      holt.update(humidity);
+      break;
+#endif
+    default:
+      break;
+  }
+}
@@ -0,0 +1,154 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ HeuristicSet.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef HeuristicSet_hpp
+#define HeuristicSet_hpp
+
+#include "CompressedHistory.h"
+#include "heuristic/AdaptiveHeuristic.h"
+#include "heuristic/AdaptiveHeuristic2.h"
+#include "heuristic/HoltHeuristic.h"
+#include "heuristic/LimiterHeuristic.h"
+#include "heuristic/LinearHeuristic.h"
+#include "heuristic/NiceToHaveHeuristic.h"
+
+//Strategies can be left out of firmware with build flag, e.g. -DWITH_LINEAR_HEURISTIC=0
+#ifndef WITH_LIMITER_HEURISTIC
+#define WITH_LIMITER_HEURISTIC 1
+#endif
+#ifndef WITH_ADAPTIVE_HEURISTIC
+#define WITH_ADAPTIVE_HEURISTIC 1
+#endif
+#ifndef WITH_ADAPTIVE2_HEURISTIC
+#define WITH_ADAPTIVE2_HEURISTIC 1
+#endif
+#ifndef WITH_NICETOHAVE_HEURISTIC
+#define WITH_NICETOHAVE_HEURISTIC 1
+#endif
+#ifndef WITH_LINEAR_HEURISTIC
+#define WITH_LINEAR_HEURISTIC 1
+#endif
+#ifndef WITH_HOLT_HEURISTIC
+#define WITH_HOLT_HEURISTIC 1
+#endif
+
+//values are stored in prefs.storage.selectedHeuristic, don't reorder
+enum HeuristicId_t : uint8_t {
+  HeuristicId_LIMITER = 0,
+  HeuristicId_ADAPTIVE = 1,
+  HeuristicId_ADAPTIVE2 = 2,
+  HeuristicId_NICETOHAVE = 3,
+  HeuristicId_LINEAR = 4,
+  HeuristicId_HOLT = 5,
+  HeuristicId_COUNT
+};
+
+struct HeuristicInfo {
+  HeuristicId_t id;
+  const char* name;
+};
+
+//All compiled in strategies, held by value and dispatched with switch. Each
+//one controls own proxy fan, see getFan().
+class HeuristicSet {
+  public:
+    static constexpr HeuristicInfo REGISTERED[] = {
+#if WITH_LIMITER_HEURISTIC
+      {HeuristicId_LIMITER, "Graniczna"},
+#endif
+#if WITH_ADAPTIVE_HEURISTIC
+      {HeuristicId_ADAPTIVE, "Adaptywna-1"},
+#endif
+#if WITH_ADAPTIVE2_HEURISTIC
+      {HeuristicId_ADAPTIVE2, "Adaptywna-2"},
+#endif
+#if WITH_NICETOHAVE_HEURISTIC
+      {HeuristicId_NICETOHAVE, "Zbieżna"},
+#endif
+#if WITH_LINEAR_HEURISTIC
+      {HeuristicId_LINEAR, "Trend"},
+#endif
+#if WITH_HOLT_HEURISTIC
+      {HeuristicId_HOLT, "Prognoza"},
+#endif
+    };
+    static constexpr std::size_t COUNT = sizeof(REGISTERED) / sizeof(REGISTERED[0]);
+
+    explicit HeuristicSet(CompressedHistory& history);
+    HeuristicSet(const HeuristicSet&) = delete;
+
+    void update(HeuristicId_t id, int humidity);
+    Fan& getFan(HeuristicId_t id);
+
+    static constexpr bool isEnabled(uint8_t id) {
+      for(const HeuristicInfo& info : REGISTERED) {
+        if (info.id == id) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //falls back to first compiled in strategy
+    static constexpr HeuristicId_t select(uint8_t id) {
+      return isEnabled(id) ? static_cast<HeuristicId_t>(id) : REGISTERED[0].id;
+    }
+  private:
+    Fan fans[HeuristicId_COUNT];
+#if WITH_LIMITER_HEURISTIC
+    LimiterHeuristic limiter;
+#endif
+#if WITH_ADAPTIVE_HEURISTIC
+    AdaptiveHeuristic adaptive;
+#endif
+#if WITH_ADAPTIVE2_HEURISTIC
+    AdaptiveHeuristic2 adaptive2;
+#endif
+#if WITH_NICETOHAVE_HEURISTIC
+    NiceToHaveHeuristic niceToHave;
+#endif
+#if WITH_LINEAR_HEURISTIC
+    LinearHeuristic linear;
+#endif
+#if WITH_HOLT_HEURISTIC
+    HoltHeuristic holt;
+#endif
+};
+
+static_assert(HeuristicSet::COUNT > 0, "at least one heuristic has to be compiled in");
+static_assert(HeuristicId_COUNT == 6, "fans are initialized for six heuristics");
+static_assert(HeuristicId_COUNT <= 8, "decisions of all heuristics have to fit uint8_t");
+
+#endif /* HeuristicSet_hpp */
@@ -0,0 +1,77 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ HoltHeuristic.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "HoltHeuristic.h"
+#include "misc/Prefs.h"
+#include "misc/TriggerPolicy.h"
+
+namespace {
+  //in %, fan stops only when forecast falls this much below trigger
+  constexpr float HYSTERESIS = 2;
+
+  //prefs keep smoothing factors in percent
+  float toFactor(uint8_t percent) {
+    percent = percent < 1 ? 1 : percent;
+    percent = percent > 100 ? 100 : percent;
+    return percent / 100.0f;
+  }
+}
+
+HoltHeuristic::HoltHeuristic(Fan& fan) : Heuristic(fan) {}
+
+void HoltHeuristic::update(int humidity) {
+  if (not initialized) {
+    level = humidity;
+    trend = 0;
+    initialized = true;
+
+  } else {
+    float alpha = toFactor(prefs.storage.holtAlpha);
+    float beta = toFactor(prefs.storage.holtBeta);
+    float prevLevel = level;
+    level = alpha * humidity + (1 - alpha) * (level + trend);
+    trend = beta * (level - prevLevel) + (1 - beta) * trend;
+  }
+
+  //keep running while still too wet, even if trend says it will dry soon
+  float expected = getForecast();
+  expected = expected > level ? expected : level;
+  float trigger = triggerPolicy.getRelativeTrigger().toFloat();
+  fan.shouldRun = expected > (fan.shouldRun ? trigger - HYSTERESIS : trigger);
+}
+
+float HoltHeuristic::getForecast() const {
+  return level + trend * prefs.storage.holtHorizon;
+}
@@ -34,10 +34,10 @@
  Author: Bartłomiej Żarnowski (Toster)
  */
 #include "LimiterHeuristic.h"
-#include "misc/Prefs.h"
+#include "misc/TriggerPolicy.h"
 
 LimiterHeuristic::LimiterHeuristic(Fan &fan) : Heuristic(fan) {}
 
 void LimiterHeuristic::update(int humidity) {
-  fan.shouldRun = (humidity > prefs.storage.humidityTrigger);
+  fan.shouldRun = triggerPolicy.isExceeded(humidity);
 }
@@ -43,7 +43,7 @@ class LimiterHeuristic : public Heuristic {
   public:
     LimiterHeuristic(Fan& fan);
 
-    void update(int humidity) override;
+    void update(int humidity);
 };
 
 
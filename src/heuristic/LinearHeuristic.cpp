@@ -27,34 +27,93 @@
  */
 #include "LinearHeuristic.h"
 
-constexpr long TIME_TO_ADD_MIN = 20 * 60 * 1000;
-constexpr int MAX_COUNT_OF_MIN_VALS = 6;
+namespace {
+  //in control ticks (seconds)
+  constexpr long TIME_TO_ADD_MIN = 20 * 60;
+  //in % per hour, tuned with tools/host replay of traces/shower.csv. Slower
+  //rise counts as flat, then humidity is compared with known minimum.
+  constexpr float RISING_SLOPE = 1.0;
+  //in seconds, trend is fitted over this much of recent history
+  constexpr uint32_t WINDOW = 30 * 60;
+  //keeps t*t sums far from int64 range
+  constexpr uint32_t REBASE_AFTER = 1UL << 16;
+}
 
-LinearHeuristic::LinearHeuristic(Fan& fan, std::vector<Measurement>& measurements)
+LinearHeuristic::LinearHeuristic(Fan& fan, CompressedHistory& measurements)
 : Heuristic(fan), measurements(measurements) {
+  if (not measurements.empty()) {
+    now = measurements.back().timestamp;
+    windowStart = now > WINDOW ? now - WINDOW : 0;
+  }
+  for(auto iter = measurements.lowerBound(windowStart); iter != measurements.end(); ++iter) {
+    oldest = regression.getCount() == 0 ? iter->timestamp : oldest;
+    regression.add(iter->timestamp, iter->humidity);
+  }
+  measurements.setListener(this);
+}
+
+LinearHeuristic::~LinearHeuristic() {
+  measurements.setListener(nullptr);
+}
+
+void LinearHeuristic::onAdded(const Measurement& m) {
+  now = m.timestamp;
+  if ((regression.getCount() > 0) and (windowStart - regression.getOrigin() > REBASE_AFTER)) {
+    regression.rebase(windowStart);
+  }
+  oldest = regression.getCount() == 0 ? m.timestamp : oldest;
+  regression.add(m.timestamp, m.humidity);
+}
+
+void LinearHeuristic::onRemoved(const Measurement& m) {
+  //usually left window long before history drops it
+  if (m.timestamp >= windowStart) {
+    regression.remove(m.timestamp, m.humidity);
+  }
+}
+
+void LinearHeuristic::onCleared() {
+  regression.clear();
+  windowStart = now;
+}
 
+//Removes samples older than WINDOW, history is change-only so they are
+//found by timestamp, not by count.
+void LinearHeuristic::slideWindow() {
+  uint32_t cutoff = now > WINDOW ? now - WINDOW : 0;
+  if (cutoff <= windowStart) {
+    return;
+  }
+  if ((regression.getCount() > 0) and (cutoff > oldest)) {
+    auto iter = measurements.lowerBound(windowStart);
+    for(; (iter != measurements.end()) and (iter->timestamp < cutoff); ++iter) {
+      regression.remove(iter->timestamp, iter->humidity);
+    }
+    oldest = iter != measurements.end() ? iter->timestamp : now;
+  }
+  windowStart = cutoff;
 }
 
 void LinearHeuristic::update(int humidity) {
   //check for min know value?
   minValue = minValue > humidity ? humidity : minValue;
-  long delta = millis() - lastUpdate;
-  if (delta > 0) {
-    timeToAddMinValue -= delta;
-    if (timeToAddMinValue < 0) {
-      storeMinValue();
-    }
+  timeToAddMinValue--;
+  if (timeToAddMinValue < 0) {
+    storeMinValue();
   }
-  lastUpdate = millis();
+
+  //history timestamps are seconds, one tick is one second
+  slideWindow();
+  now++;
 
   //detect raising slope
-  float a = calcCoefficient();
-  fan.shouldRun = a > 0.45;
+  float a = regression.getSlope() * 3600;
+  fan.shouldRun = a > RISING_SLOPE;
 
   //fan is probably working, or flat readings, see if humidity is above known minimal value
   //if yes air is saturated and need some time to blow out all humidity but no
   //peak is detected, so we need to check known minimal values
-  if ((a > 0) && (a < 0.1) && (fan.shouldRun == false)) {
+  if ((a > 0) && (fan.shouldRun == false)) {
     fan.shouldRun = isAboveMin(humidity);
   }
 }
@@ -71,40 +130,7 @@ bool LinearHeuristic::isAboveMin(int humidity) {
 
 void LinearHeuristic::storeMinValue() {
   timeToAddMinValue = TIME_TO_ADD_MIN;
+  //oldest is dropped when full
   minValues.push_back(minValue);
   minValue = 100;  //some big value :)
-  //remove if too many
-  if (minValues.size() > MAX_COUNT_OF_MIN_VALS) {
-    minValues.erase(minValues.begin());
-  }
-}
-
-void LinearHeuristic::calcMeans(float& x, float& y) {
-  x = 0;
-  y = 0;
-  int32_t startT = measurements[0].timestamp;
-
-  for(const Measurement m : measurements) {
-    x += m.humidity;
-    y += m.timestamp - startT;
-  }
-  x /= measurements.size();
-  y /= measurements.size();
-}
-
-float LinearHeuristic::calcCoefficient() {
-  if (measurements.size() == 0) {
-      return 0;
-  }
-  float meanX, meanY;
-  calcMeans(meanX, meanY);
-  int32_t startT = measurements[0].timestamp;
-
-  float bottom = 0;
-  float top = 0;
-  for (const Measurement m : measurements) {
-    top += (m.humidity - meanX) * (m.timestamp - startT - meanY);
-    bottom += (m.humidity - meanX) * (m.humidity - meanX);
-  }
-  return top / bottom;
 }
@@ -29,26 +29,41 @@
 #define LinearHeuristic_hpp
 
 #include "Heuristic.h"
-#include "Measurement.h"
-#include <vector>
+#include "CompressedHistory.h"
+#include "misc/LinearRegression.h"
+#include "misc/RingBuffer.h"
 
-class LinearHeuristic : public Heuristic {
+//Fan runs while humidity trend over last minutes is rising, or when trend
+//is flat but humidity is above minimum known from last two hours. Trend is
+//fitted incrementally as samples enter history and leave the window.
+class LinearHeuristic : public Heuristic, public HistoryListener {
   public:
-    LinearHeuristic(Fan& fan, std::vector<Measurement>& measurements);
-    virtual ~LinearHeuristic() override = default;
+    LinearHeuristic(Fan& fan, CompressedHistory& measurements);
+    ~LinearHeuristic() override;
 
-    void update(int humidity) override;
+    void update(int humidity);
+
+    void onAdded(const Measurement& m) override;
+    void onRemoved(const Measurement& m) override;
+    void onCleared() override;
   private:
-    std::vector<Measurement>& measurements;
-    std::vector<int8_t> minValues;
-    unsigned long lastUpdate = 0;
+    static constexpr std::size_t MAX_COUNT_OF_MIN_VALS = 6;
+
+    CompressedHistory& measurements;
+    LinearRegression regression;
+    int8_t minValuesBuff[MAX_COUNT_OF_MIN_VALS] = {};
+    RingBuffer<int8_t, MAX_COUNT_OF_MIN_VALS> minValues{minValuesBuff};
     long timeToAddMinValue = 0;
-    int8_t minValue = 0;
+    int8_t minValue = 100;
+    //seconds, history samples from windowStart on are in regression
+    uint32_t now = 0;
+    uint32_t windowStart = 0;
+    //timestamp of oldest sample in regression, history is searched only after it leaves
+    uint32_t oldest = 0;
 
+    void slideWindow();
     void storeMinValue();
-    float calcCoefficient();
     bool isAboveMin(int humidity);
-    void calcMeans(float& x, float& y);
 };
 
 #endif /* LinearHeuristic_hpp */
@@ -43,7 +43,7 @@
 class NiceToHaveHeuristic : public Heuristic {
   public:
     NiceToHaveHeuristic(Fan &fan);
-    void update(int humidity) override;
+    void update(int humidity);
   private:
     uint8_t minKnowHum = 100;
     int time = 0;
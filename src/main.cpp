@@ -9,10 +9,15 @@
 #include "misc/Prefs.h"
 #include "periphery/Buttons.h"
 #include "misc/lfont.h"
+#include "FlashLog.h"
+#include "TraceCapture.h"
+#include "misc/Clock.h"
 
 #define TIME_TO_RESET (1000 * 24 * 3600)
+#define DISPLAY_INTERVAL 200
 
 SSD1306  display(0x3c, 5, 4);
+unsigned long lastDisplay = 0;
 
 void setup() {
   Serial.begin(115200);
@@ -29,6 +34,8 @@ void setup() {
   display.display();
 
   prefs.load();
+  flashLog.begin();
+  systemClock.begin();
   myServer.restart();
 
   //dump prefs
@@ -45,9 +52,7 @@ void setup() {
   Serial.flush();
 }
 
-void normalMode() {
-  envLogic.update();
-  myServer.update();
+void drawStatus() {
   display.clear();
   display.setColor(WHITE);
   display.setTextAlignment(TEXT_ALIGN_LEFT);
@@ -72,7 +77,23 @@ void normalMode() {
       hCenter ? (display.getHeight() - 42) / 2 : 16,
       str);
   display.display();
-  delay(200);
+}
+
+void normalMode() {
+  envLogic.update();
+  flashLog.update();
+  traceCapture.update();
+  myServer.update();
+  //display refresh stays at 5 Hz
+  if (millis() - lastDisplay >= DISPLAY_INTERVAL) {
+    lastDisplay = millis();
+    drawStatus();
+  }
+  //sleep until reading, control tick or display refresh is due, short
+  //sleeps only while sensor converts
+  unsigned long sinceDisplay = millis() - lastDisplay;
+  unsigned long idle = sinceDisplay < DISPLAY_INTERVAL ? DISPLAY_INTERVAL - sinceDisplay : 0;
+  delay(std::min(idle, (unsigned long)envLogic.getIdleTime()));
 }
 
 void configMode() {
@@ -89,6 +110,8 @@ void configMode() {
 }
 
 void loop() {
+  systemClock.update();
+
   //updater has it's own display management
   if (updater.update()) {
     return;
@@ -0,0 +1,87 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ AdaptiveSampler.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "misc/AdaptiveSampler.h"
+#include "misc/Prefs.h"
+
+constexpr uint32_t AdaptiveSampler::INTERVALS[];
+
+void AdaptiveSampler::update(uint64_t now, Fixed humidity, bool fanRunning) {
+  samples[mode]++;
+  if (not hasReference) {
+    hasReference = true;
+    reference = humidity;
+    referenceTime = now;
+    lastActive = now;
+  }
+
+  uint32_t elapsed = now - referenceTime;
+  if (elapsed >= RATE_WINDOW) {
+    rate = (humidity - reference) / Fixed::ratio(elapsed, 60000UL);
+    reference = humidity;
+    referenceTime = now;
+  }
+
+  bool active = fanRunning or (Fixed::abs(rate) > Fixed::ratio(prefs.storage.activeRate, 10));
+  if (active) {
+    lastActive = now;
+  }
+
+  if (prefs.storage.adaptiveSampling == 0) {
+    mode = SamplingMode_NORMAL;
+  } else if (active) {
+    mode = SamplingMode_FAST;
+  } else if (now - lastActive < prefs.storage.settleTime * 1000ULL) {
+    mode = SamplingMode_NORMAL;
+  } else {
+    mode = SamplingMode_SLOW;
+  }
+}
+
+uint32_t AdaptiveSampler::getInterval() const {
+  return INTERVALS[mode];
+}
+
+SamplingMode_t AdaptiveSampler::getMode() const {
+  return mode;
+}
+
+Fixed AdaptiveSampler::getRate() const {
+  return rate;
+}
+
+uint32_t AdaptiveSampler::getSamples(SamplingMode_t mode) const {
+  return samples[mode];
+}
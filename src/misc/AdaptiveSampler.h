@@ -0,0 +1,78 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ AdaptiveSampler.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef AdaptiveSampler_hpp
+#define AdaptiveSampler_hpp
+
+#include <Arduino.h>
+#include "misc/Fixed.h"
+
+enum SamplingMode_t : uint8_t {
+  SamplingMode_FAST = 0,    //humidity is moving or fan runs
+  SamplingMode_NORMAL = 1,  //calm, but not for settleTime yet
+  SamplingMode_SLOW = 2,    //stable and fan idle
+  SamplingMode_COUNT
+};
+
+//Chooses sensor polling interval from signal activity. Rate of change is
+//measured on raw humidity over at least RATE_WINDOW, shorter spans are
+//dominated by sensor noise. Sampling is fast while rate exceeds
+//prefs.storage.activeRate or fan runs and slows down after settleTime of calm.
+class AdaptiveSampler {
+  public:
+    static constexpr uint32_t INTERVALS[SamplingMode_COUNT] = {250, 1000, 30000};
+    static constexpr uint32_t RATE_WINDOW = 30000;
+
+    //timestamp in ms, see Clock::now()
+    void update(uint64_t now, Fixed humidity, bool fanRunning);
+
+    //ms until next reading
+    uint32_t getInterval() const;
+    SamplingMode_t getMode() const;
+    //%/min, last measured
+    Fixed getRate() const;
+    //readings taken in given mode
+    uint32_t getSamples(SamplingMode_t mode) const;
+  private:
+    SamplingMode_t mode = SamplingMode_NORMAL;
+    bool hasReference = false;
+    uint64_t referenceTime = 0;
+    Fixed reference;
+    Fixed rate;
+    uint64_t lastActive = 0;
+    uint32_t samples[SamplingMode_COUNT] = {};
+};
+
+#endif /* AdaptiveSampler_hpp */
@@ -0,0 +1,87 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ChunkedResponse.cpp
+ Created on: Oct 17, 2026
+ */
+#include "misc/ChunkedResponse.h"
+#include <ESP8266WebServer.h>
+
+ChunkedResponse::ChunkedResponse(ESP8266WebServer& server, int code, const char* contentType) :
+    server(server), used(0), finished(false) {
+  //unknown length makes server use chunked encoding
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(code, contentType, "");
+}
+
+ChunkedResponse::~ChunkedResponse() {
+  end();
+}
+
+size_t ChunkedResponse::write(uint8_t c) {
+  if (used == BUFFER_SIZE) {
+    sendBuffer();
+  }
+  buffer[used++] = c;
+  return 1;
+}
+
+size_t ChunkedResponse::write(const uint8_t* data, size_t len) {
+  size_t left = len;
+  while (left > 0) {
+    if (used == BUFFER_SIZE) {
+      sendBuffer();
+    }
+    std::size_t part = BUFFER_SIZE - used < left ? BUFFER_SIZE - used : left;
+    memcpy(buffer + used, data, part);
+    used += part;
+    data += part;
+    left -= part;
+  }
+  return len;
+}
+
+void ChunkedResponse::sendBuffer() {
+  if (used > 0) {
+    server.sendContent(buffer, used);
+    used = 0;
+  }
+}
+
+void ChunkedResponse::end() {
+  if (finished) {
+    return;
+  }
+  sendBuffer();
+  //empty chunk ends response
+  server.sendContent("");
+  finished = true;
+}
@@ -0,0 +1,66 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ChunkedResponse.h
+ Created on: Oct 17, 2026
+ */
+#ifndef ChunkedResponse_hpp
+#define ChunkedResponse_hpp
+
+#include <Arduino.h>
+
+class ESP8266WebServer;
+
+//Response body sent with chunked transfer encoding while it is generated.
+//Output is collected in fixed buffer and sent as one chunk when buffer is
+//full, so memory used does not depend on size of response. Response is
+//finished by end() or destructor.
+class ChunkedResponse : public Print {
+  public:
+    static constexpr std::size_t BUFFER_SIZE = 256;
+
+    ChunkedResponse(ESP8266WebServer& server, int code, const char* contentType);
+    ~ChunkedResponse();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t len) override;
+    using Print::write;
+    void end();
+  private:
+    ESP8266WebServer& server;
+    char buffer[BUFFER_SIZE];
+    std::size_t used;
+    bool finished;
+
+    void sendBuffer();
+};
+
+#endif /* ChunkedResponse_hpp */
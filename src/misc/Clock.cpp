@@ -0,0 +1,86 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Clock.cpp
+ Created on: Oct 17, 2026
+ */
+#include "misc/Clock.h"
+#include <time.h>
+#include <sys/time.h>
+
+Clock systemClock;
+
+namespace {
+  //anything earlier means SNTP did not set time yet
+  constexpr time_t MIN_VALID_EPOCH = 1500000000;
+}
+
+void Clock::begin() {
+  configTime(0, 0, SNTP_SERVER);
+}
+
+void Clock::update() {
+  uint64_t mono = now();
+  if (mono - lastSyncCheck < 1000) {
+    return;
+  }
+  lastSyncCheck = mono;
+
+  timeval tv;
+  gettimeofday(&tv, nullptr);
+  if (tv.tv_sec < MIN_VALID_EPOCH) {
+    return;
+  }
+  //follow SNTP corrections, timeline itself stays monotonic
+  epochOffset = (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000 - (int64_t)mono;
+  anchored = true;
+}
+
+uint64_t Clock::now() {
+  uint32_t mil = millis();
+  if (mil < lastMillis) {
+    wraps++;
+  }
+  lastMillis = mil;
+  return ((uint64_t)wraps << 32) | mil;
+}
+
+uint32_t Clock::seconds() {
+  return now() / 1000;
+}
+
+bool Clock::isAnchored() const {
+  return anchored;
+}
+
+uint32_t Clock::getBootEpoch() const {
+  return anchored ? epochOffset / 1000 : 0;
+}
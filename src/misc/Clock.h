@@ -0,0 +1,68 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Clock.h
+ Created on: Oct 17, 2026
+ */
+#ifndef Clock_hpp
+#define Clock_hpp
+
+#include <Arduino.h>
+
+#ifndef SNTP_SERVER
+#define SNTP_SERVER "pool.ntp.org"
+#endif
+
+//Monotonic time since boot which does not wrap like millis() does, plus
+//mapping to wall clock once SNTP has answered. History keeps compact
+//uint32 seconds from boot, getBootEpoch() turns them into unix time.
+class Clock {
+  public:
+    void begin();
+    void update();
+    //milliseconds since boot, must be called at least once per 49 days
+    uint64_t now();
+    //seconds since boot, timestamp used by history
+    uint32_t seconds();
+    bool isAnchored() const;
+    //unix time of boot, 0 if SNTP has not answered yet
+    uint32_t getBootEpoch() const;
+  private:
+    uint32_t lastMillis = 0;
+    uint32_t wraps = 0;
+    bool anchored = false;
+    int64_t epochOffset = 0;  //unix time in ms minus now()
+    uint64_t lastSyncCheck = 0;
+};
+
+extern Clock systemClock;
+
+#endif /* Clock_hpp */
@@ -0,0 +1,200 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Filters.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef Filters_hpp
+#define Filters_hpp
+
+#include <Arduino.h>
+#include "misc/Fixed.h"
+
+//Exponential low-pass, output starts at first sample instead of 0
+class EmaFilter {
+  public:
+    //weight of previous output, 0..1
+    explicit EmaFilter(Fixed eta) : eta(eta) {}
+
+    Fixed update(Fixed value) {
+      output = initialized ? value + (output - value) * eta : value;
+      initialized = true;
+      return output;
+    }
+
+    void reset() {
+      initialized = false;
+    }
+
+    Fixed getOutput() const {
+      return output;
+    }
+  private:
+    Fixed eta;
+    bool initialized = false;
+    Fixed output;
+};
+
+//1-D Kalman filter for slowly wandering value (random walk model). q is
+//variance of real change between samples, r variance of sensor noise. Gain
+//settles on its own, so it follows fast rise better than EMA with fixed eta.
+class KalmanFilter {
+  public:
+    Fixed update(Fixed value, Fixed q, Fixed r) {
+      if (not initialized) {
+        output = value;
+        p = r;
+        initialized = true;
+        return output;
+      }
+      p += q;
+      Fixed k = p / (p + r);
+      output += k * (value - output);
+      p *= Fixed(1) - k;
+      return output;
+    }
+
+    void reset() {
+      initialized = false;
+    }
+
+    Fixed getOutput() const {
+      return output;
+    }
+
+    //variance of current output
+    Fixed getVariance() const {
+      return p;
+    }
+  private:
+    bool initialized = false;
+    Fixed output;
+    Fixed p;  //estimate variance
+};
+
+//Median of last size samples (up to N), rejects single sample spikes
+template<std::size_t N>
+class MedianFilter {
+  public:
+    Fixed update(Fixed value, std::size_t size) {
+      size = size < 1 ? 1 : (size > N ? N : size);
+      if (size != window) {
+        window = size;
+        count = 0;
+        head = 0;
+      }
+      samples[head] = value;
+      head = (head + 1) % window;
+      count = count < window ? count + 1 : window;
+
+      //insertion sort of few values is cheaper than anything smarter
+      Fixed sorted[N];
+      for(std::size_t i = 0; i < count; i++) {
+        std::size_t j = i;
+        for(; (j > 0) and (sorted[j - 1] > samples[i]); j--) {
+          sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = samples[i];
+      }
+      output = sorted[count / 2];
+      return output;
+    }
+
+    void reset() {
+      count = 0;
+      head = 0;
+    }
+
+    Fixed getOutput() const {
+      return output;
+    }
+  private:
+    Fixed samples[N];
+    std::size_t window = 1;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    Fixed output;
+};
+
+//Holds output until input moves more than band away from it
+class DeadbandFilter {
+  public:
+    Fixed update(Fixed value, Fixed band) {
+      if ((not initialized) or (Fixed::abs(value - output) > band)) {
+        output = value;
+        initialized = true;
+      }
+      return output;
+    }
+
+    void reset() {
+      initialized = false;
+    }
+
+    Fixed getOutput() const {
+      return output;
+    }
+  private:
+    bool initialized = false;
+    Fixed output;
+};
+
+//Output follows input by at most maxStep per sample
+class RateLimiter {
+  public:
+    Fixed update(Fixed value, Fixed maxStep) {
+      if (not initialized) {
+        output = value;
+        initialized = true;
+      } else if (value > output + maxStep) {
+        output += maxStep;
+      } else if (value < output - maxStep) {
+        output -= maxStep;
+      } else {
+        output = value;
+      }
+      return output;
+    }
+
+    void reset() {
+      initialized = false;
+    }
+
+    Fixed getOutput() const {
+      return output;
+    }
+  private:
+    bool initialized = false;
+    Fixed output;
+};
+
+#endif /* Filters_hpp */
@@ -0,0 +1,172 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Fixed.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef Fixed_hpp
+#define Fixed_hpp
+
+#include <Arduino.h>
+
+//Signed Q16.16 fixed point number, range +-32768 with 1/65536 resolution.
+//ESP8266 has no FPU, every float operation is emulated in software, this
+//needs only integer ALU (64 bit intermediate in multiply and divide).
+class Fixed {
+  public:
+    static constexpr int FRAC_BITS = 16;
+    static constexpr int32_t ONE = 1L << FRAC_BITS;
+
+    constexpr Fixed() : raw(0) {}
+    constexpr Fixed(int value) : raw(value * ONE) {}
+    //no silent truncation of literals like 0.5, use fromFloat()
+    Fixed(float) = delete;
+    Fixed(double) = delete;
+
+    static constexpr Fixed fromRaw(int32_t raw) {
+      return Fixed(raw, true);
+    }
+
+    static constexpr Fixed fromFloat(float value) {
+      return Fixed(static_cast<int32_t>(value * ONE + (value < 0 ? -0.5f : 0.5f)), true);
+    }
+
+    //num / den without going through float, e.g. pref in 0.1 % units
+    static constexpr Fixed ratio(int64_t num, int64_t den) {
+      return Fixed(static_cast<int32_t>(num * ONE / den), true);
+    }
+
+    constexpr int32_t getRaw() const {
+      return raw;
+    }
+
+    float toFloat() const {
+      return static_cast<float>(raw) / ONE;
+    }
+
+    //rounded to nearest
+    int toInt() const {
+      return (raw + ONE / 2) >> FRAC_BITS;
+    }
+
+    constexpr Fixed operator-() const {
+      return fromRaw(-raw);
+    }
+
+    constexpr Fixed operator+(Fixed other) const {
+      return fromRaw(raw + other.raw);
+    }
+
+    constexpr Fixed operator-(Fixed other) const {
+      return fromRaw(raw - other.raw);
+    }
+
+    constexpr Fixed operator*(Fixed other) const {
+      return fromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) * other.raw) >> FRAC_BITS));
+    }
+
+    constexpr Fixed operator/(Fixed other) const {
+      return fromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) << FRAC_BITS) / other.raw));
+    }
+
+    //integer factor needs no 64 bit math
+    constexpr Fixed operator*(int value) const {
+      return fromRaw(raw * value);
+    }
+
+    constexpr Fixed operator/(int value) const {
+      return fromRaw(raw / value);
+    }
+
+    Fixed& operator+=(Fixed other) {
+      raw += other.raw;
+      return *this;
+    }
+
+    Fixed& operator-=(Fixed other) {
+      raw -= other.raw;
+      return *this;
+    }
+
+    Fixed& operator*=(Fixed other) {
+      return *this = *this * other;
+    }
+
+    Fixed& operator/=(Fixed other) {
+      return *this = *this / other;
+    }
+
+    constexpr bool operator==(Fixed other) const { return raw == other.raw; }
+    constexpr bool operator!=(Fixed other) const { return raw != other.raw; }
+    constexpr bool operator<(Fixed other) const { return raw < other.raw; }
+    constexpr bool operator>(Fixed other) const { return raw > other.raw; }
+    constexpr bool operator<=(Fixed other) const { return raw <= other.raw; }
+    constexpr bool operator>=(Fixed other) const { return raw >= other.raw; }
+
+    static constexpr Fixed abs(Fixed value) {
+      return value.raw < 0 ? -value : value;
+    }
+
+    //negative input gives 0
+    static Fixed sqrt(Fixed value) {
+      if (value.raw <= 0) {
+        return Fixed();
+      }
+      //sqrt(raw / ONE) * ONE == sqrt(raw * ONE)
+      return fromRaw(isqrt(static_cast<uint64_t>(value.raw) << FRAC_BITS));
+    }
+
+    //floor of square root, one result bit per iteration
+    static uint32_t isqrt(uint64_t value) {
+      uint64_t result = 0;
+      uint64_t bit = 1ULL << 62;
+      while (bit > value) {
+        bit >>= 2;
+      }
+      while (bit != 0) {
+        if (value >= result + bit) {
+          value -= result + bit;
+          result = (result >> 1) + bit;
+        } else {
+          result >>= 1;
+        }
+        bit >>= 2;
+      }
+      return static_cast<uint32_t>(result);
+    }
+  private:
+    int32_t raw;
+
+    constexpr Fixed(int32_t raw, bool) : raw(raw) {}
+};
+
+#endif /* Fixed_hpp */
@@ -0,0 +1,114 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ LinearRegression.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef LinearRegression_hpp
+#define LinearRegression_hpp
+
+#include <Arduino.h>
+
+//Least squares fit h = a + b*t kept as exact integer sums, so points can be
+//added and removed in O(1) without accumulating rounding error. Time is
+//stored relative to an origin, rebase() moves it forward to keep t*t small.
+class LinearRegression {
+  public:
+    void add(uint32_t t, int h) {
+      if (count == 0) {
+        origin = t;
+      }
+      int64_t x = (int64_t)t - origin;
+      count++;
+      sumT += x;
+      sumH += h;
+      sumTT += x * x;
+      sumTH += x * h;
+    }
+
+    void remove(uint32_t t, int h) {
+      if (count <= 1) {
+        clear();
+        return;
+      }
+      int64_t x = (int64_t)t - origin;
+      count--;
+      sumT -= x;
+      sumH -= h;
+      sumTT -= x * x;
+      sumTH -= x * h;
+    }
+
+    //shifts sums to new time origin, result is identical
+    void rebase(uint32_t newOrigin) {
+      int64_t d = (int64_t)newOrigin - origin;
+      sumTT += -2 * d * sumT + count * d * d;
+      sumTH -= d * sumH;
+      sumT -= count * d;
+      origin = newOrigin;
+    }
+
+    void clear() {
+      count = 0;
+      origin = 0;
+      sumT = sumH = sumTT = sumTH = 0;
+    }
+
+    //dh/dt in humidity units per second, 0 when undefined
+    float getSlope() const {
+      if (count < 2) {
+        return 0;
+      }
+      //centered sums, only this step is done in floating point
+      double n = count;
+      double sxx = sumTT - (double)sumT * sumT / n;
+      double sxy = sumTH - (double)sumT * sumH / n;
+      return sxx > 0 ? sxy / sxx : 0;
+    }
+
+    uint32_t getCount() const {
+      return count;
+    }
+
+    uint32_t getOrigin() const {
+      return origin;
+    }
+  private:
+    uint32_t count = 0;
+    uint32_t origin = 0;
+    int64_t sumT = 0;
+    int64_t sumH = 0;
+    int64_t sumTT = 0;
+    int64_t sumTH = 0;
+};
+
+#endif /* LinearRegression_hpp */
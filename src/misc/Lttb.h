@@ -0,0 +1,107 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Lttb.h
+ Created on: Oct 17, 2026
+ */
+#ifndef Lttb_hpp
+#define Lttb_hpp
+
+#include <cstddef>
+#include <cmath>
+
+//Largest-Triangle-Three-Buckets downsampling of n points starting at first.
+//Needs only forward iterator, each point is visited at most three times. Selected points
+//are passed to out() in order. xOf/yOf extract coordinates of point.
+template<typename It, typename XOf, typename YOf, typename Out>
+void lttb(It first, std::size_t n, std::size_t threshold, XOf xOf, YOf yOf, Out out) {
+  if ((threshold >= n) or (threshold < 3)) {
+    for(std::size_t t = 0; t < n; t++, ++first) {
+      out(*first);
+    }
+    return;
+  }
+
+  //first point is always selected
+  It cur = first;
+  float ax = xOf(*cur);
+  float ay = yOf(*cur);
+  out(*cur);
+  ++cur;
+
+  const float every = (float)(n - 2) / (threshold - 2);
+  It next = cur;
+  std::size_t nextStart = 1;
+  std::size_t curStart = 1;
+  for(std::size_t i = 0; i < threshold - 2; i++) {
+    std::size_t curEnd = (std::size_t)((i + 1) * every) + 1;
+    //average of next bucket, last bucket looks at last point
+    std::size_t nextEnd = (std::size_t)((i + 2) * every) + 1;
+    nextEnd = nextEnd > n ? n : nextEnd;
+    while (nextStart < curEnd) {
+      ++next;
+      nextStart++;
+    }
+    float avgX = 0;
+    float avgY = 0;
+    std::size_t count = 0;
+    for(; nextStart < nextEnd; nextStart++, ++next, count++) {
+      avgX += xOf(*next);
+      avgY += yOf(*next);
+    }
+    if (count > 0) {
+      avgX /= count;
+      avgY /= count;
+    }
+
+    float maxArea = -1;
+    It selected = cur;
+    for(; curStart < curEnd; curStart++, ++cur) {
+      float area = std::fabs((ax - avgX) * (yOf(*cur) - ay) - (ax - xOf(*cur)) * (avgY - ay));
+      if (area > maxArea) {
+        maxArea = area;
+        selected = cur;
+      }
+    }
+    ax = xOf(*selected);
+    ay = yOf(*selected);
+    out(*selected);
+  }
+
+  //last point is always selected
+  while (curStart < n - 1) {
+    ++cur;
+    curStart++;
+  }
+  out(*cur);
+}
+
+#endif /* Lttb_hpp */
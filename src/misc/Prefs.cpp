@@ -35,29 +35,61 @@
  */
 #include "misc/Prefs.h"
 #include <EEPROM.h>
+#include "misc/TriggerPolicy.h"
 
 Prefs prefs;
 
+namespace {
+  constexpr std::size_t EEPROM_SIZE = 512;
+  constexpr uint8_t PREFS_VERSION = 2;
+  //stored bytes of each layout version, later version only appends fields
+  constexpr std::size_t LAYOUT_SIZE[PREFS_VERSION + 1] = {
+    offsetof(SavedPrefs, version),
+    offsetof(SavedPrefs, statsWindow),
+    sizeof(SavedPrefs)
+  };
+
+  static_assert(sizeof(SavedPrefs) <= EEPROM_SIZE, "prefs don't fit in EEPROM");
+}
+
 void Prefs::load() {
-  EEPROM.begin(512);
+  EEPROM.begin(EEPROM_SIZE);
   EEPROM.get(0, storage);
   EEPROM.end();
-  uint8_t expectedCrc = calcCRC();
+  uint8_t version = findStoredVersion();
 
   Serial.print("StorageCrc:");
   Serial.println(storage.crc);
-  Serial.print("Expected CRC:");
-  Serial.println(expectedCrc);
+  Serial.print("Prefs version:");
+  Serial.println(version);
   Serial.print("Is zero prefs:");
   Serial.println(isZeroPrefs());
   Serial.flush();
 
-  //if (storage.crc != expectedCrc || isZeroPrefs()) {
+  if ((version < PREFS_VERSION) and (not isZeroPrefs())) {
+    //keep network and older settings, fill only fields added since
+    Serial.println("Upgrading prefs");
+    defaultsSince(version);
+    save();
+  }
   if (not hasPrefs()) {
     defaultValues();
   }
 }
 
+//Newest layout is checked first, old firmware left random byte where
+//version is now.
+uint8_t Prefs::findStoredVersion() {
+  uint8_t version = storage.version;
+  if ((version > 0) and (version <= PREFS_VERSION) and (storage.crc == calcCRC(LAYOUT_SIZE[version]))) {
+    return version;
+  }
+  if (storage.crc == calcCRC(LAYOUT_SIZE[0])) {
+    return 0;
+  }
+  return NO_VERSION;
+}
+
 bool Prefs::hasPrefs() {
   return (storage.crc == calcCRC()) && (not isZeroPrefs()) && (prefs.storage.ssid[0] != 0);
 }
@@ -94,20 +126,57 @@ void Prefs::defaultValues() {
   memset(&storage.username[0], 0, sizeof(storage.username));
   strcpy(&storage.username[0], "Lampster");
   memset(&storage.userPassword[0], 0, sizeof(storage.userPassword));
+
+  defaultsSince(0);
+}
+
+//Defaults of fields appended after given layout version, when new version
+//is added its fields get own block here.
+void Prefs::defaultsSince(uint8_t version) {
+  if (version < 1) {
+    storage.holtAlpha = 30;
+    storage.holtBeta = 10;
+    storage.holtHorizon = 120;
+
+    storage.adaptiveSampling = 1;
+    storage.activeRate = 20;
+    storage.settleTime = 300;
+
+    memset(storage.pipeline, Stage_NONE, sizeof(storage.pipeline));
+    storage.pipeline[0] = Stage_MEDIAN;
+    storage.pipeline[1] = Stage_KALMAN;
+    storage.pipeline[2] = Stage_DEADBAND;
+    storage.medianSize = 5;
+    storage.deadband = 6;
+    storage.rateLimit = 20;
+    storage.kalmanQ = 50;
+    storage.kalmanR = 500;
+
+    storage.triggerMode = TriggerMode_RELATIVE;
+    storage.absoluteTrigger = 120;
+    storage.dewPointSpread = 70;
+  }
+  if (version < 2) {
+    storage.statsWindow[0] = 10;
+    storage.statsWindow[1] = 60;
+    storage.statsWindow[2] = 24 * 60;
+  }
+  storage.version = PREFS_VERSION;
 }
 
 void Prefs::save() {
   storage.crc = calcCRC();
-  EEPROM.begin(512);
+  EEPROM.begin(EEPROM_SIZE);
   EEPROM.put(0, storage);
   EEPROM.commit();
   EEPROM.end();
 }
 
-uint8_t Prefs::calcCRC() {
+//crc of first size bytes of storage
+uint8_t Prefs::calcCRC(std::size_t size) {
   const uint8_t* data = (uint8_t*)&storage;
   data++; //skip crc field
-  int len = sizeof(storage) - 1;
+  int len = size - 1;
   uint8_t crc = 0x00;
   while (len--) {
     byte extract = *data++;
@@ -36,6 +36,7 @@
 #ifndef Prefs_hpp
 #define Prefs_hpp
 #include <Arduino.h>
+#include "misc/SignalPipeline.h"
 
 struct SavedPrefs {
     uint8_t crc;
@@ -59,7 +60,35 @@ struct SavedPrefs {
     uint8_t noSamples;  //used by AdaptiveHeuristic1/2
     uint16_t timeToForget; //in seconds, used by NiceToHaveHeuristic
     uint8_t knownHumDiffTrigger; //in % used by NiceToHaveHeuristic
-    int8_t humidityTrigger;  //used by LimiterHeuristic and Disturber
+    int8_t humidityTrigger;  //in %, see TriggerPolicy
+
+    //Fields above are laid out as in first firmware, which had no version.
+    //New fields are only appended, see Prefs::load().
+    uint8_t version;
+    uint8_t holtAlpha;  //in %, level smoothing, used by HoltHeuristic
+    uint8_t holtBeta;   //in %, trend smoothing, used by HoltHeuristic
+    uint16_t holtHorizon;  //in seconds, how far HoltHeuristic looks ahead
+
+    //Sensor sampling
+    uint8_t adaptiveSampling;  //0 - every second, else see AdaptiveSampler
+    uint8_t activeRate;  //in 0.1 %/min, faster change switches to fast sampling
+    uint16_t settleTime;  //in seconds of calm before slow sampling
+
+    //Sensor filtering
+    uint8_t pipeline[SignalPipeline::MAX_STAGES];  //Stage_t in order of processing, Stage_NONE ends
+    uint8_t medianSize;  //in seconds (pipeline steps), window of median stage
+    uint8_t deadband;  //in 0.1 %, change smaller than this is ignored
+    uint8_t rateLimit;  //in 0.1 %, max change of output per second
+    uint16_t kalmanQ;  //in 0.001 %^2, expected variance of humidity change per second
+    uint16_t kalmanR;  //in 0.001 %^2, variance of sensor noise
+
+    //Trigger, humidityTrigger is used in relative mode
+    uint8_t triggerMode;  //see TriggerMode_t
+    uint8_t absoluteTrigger;  //in 0.1 g/m3
+    uint8_t dewPointSpread;  //in 0.1 C, too wet when dew point is closer to temperature
+
+    //Statistics, version 2
+    uint16_t statsWindow[3];  //in minutes, windows of /stats
 };
 
 class Prefs {
@@ -71,7 +100,11 @@ class Prefs {
     bool hasPrefs();
     void load();
   private:
-    uint8_t calcCRC();
+    static constexpr uint8_t NO_VERSION = 0xFF;
+
+    uint8_t calcCRC(std::size_t size = sizeof(SavedPrefs));
+    uint8_t findStoredVersion();
+    void defaultsSince(uint8_t version);
 
     bool isZeroPrefs();
 };
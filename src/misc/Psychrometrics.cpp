@@ -0,0 +1,113 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Psychrometrics.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "misc/Psychrometrics.h"
+
+namespace {
+  //611.2 * exp(17.62 * t / (243.12 + t)) in 0.1 Pa, t = TABLE_MIN..TABLE_MAX
+  const uint32_t SATURATION_TABLE[] PROGMEM = {
+    1260, 1372, 1494, 1625, 1766, 1919, 2083, 2259, 2448, 2652,
+    2870, 3105, 3356, 3625, 3913, 4222, 4552, 4904, 5281, 5683,
+    6112, 6569, 7057, 7576, 8129, 8717, 9343, 10008, 10714, 11464,
+    12260, 13105, 14000, 14948, 15953, 17017, 18142, 19333, 20591, 21921,
+    23326, 24809, 26374, 28025, 29766, 31601, 33533, 35569, 37711, 39966,
+    42337, 44830, 47450, 50203, 53094, 56128, 59313, 62653, 66156, 69827,
+    73675, 77704, 81924, 86341, 90963, 95797, 100852, 106137, 111659, 117427,
+    123452, 129741, 136304, 143152, 150294, 157742, 165504, 173593, 182020, 190796,
+    199933,
+  };
+  constexpr int TABLE_LAST = Psychrometrics::TABLE_MAX - Psychrometrics::TABLE_MIN;
+  static_assert(sizeof(SATURATION_TABLE) / sizeof(SATURATION_TABLE[0]) == TABLE_LAST + 1,
+      "one entry per degree");
+
+  //ideal gas: absolute [g/m3] = vapour pressure [Pa] * WATER_FACTOR / T [K]
+  constexpr Fixed WATER_FACTOR = Fixed::fromFloat(2.1674f);
+  constexpr Fixed ZERO_CELSIUS = Fixed::fromFloat(273.15f);
+
+  Fixed tableAt(int index) {
+    return Fixed::ratio(pgm_read_dword(&SATURATION_TABLE[index]), 10);
+  }
+}
+
+Fixed Psychrometrics::saturationPressure(Fixed temperature) {
+  Fixed offset = temperature - TABLE_MIN;
+  if (offset <= 0) {
+    return tableAt(0);
+  }
+  int index = offset.getRaw() >> Fixed::FRAC_BITS;
+  if (index >= TABLE_LAST) {
+    return tableAt(TABLE_LAST);
+  }
+  Fixed low = tableAt(index);
+  return low + (tableAt(index + 1) - low) * (offset - index);
+}
+
+Fixed Psychrometrics::absoluteHumidity(Fixed relative, Fixed temperature) {
+  //divide before multiply, vapour pressure alone is close to Q16.16 range
+  Fixed pressure = saturationPressure(temperature) * (relative / 100);
+  return pressure / (temperature + ZERO_CELSIUS) * WATER_FACTOR;
+}
+
+Fixed Psychrometrics::dewPoint(Fixed relative, Fixed temperature) {
+  Fixed pressure = saturationPressure(temperature) * (relative / 100);
+  if (pressure <= tableAt(0)) {
+    return TABLE_MIN;
+  }
+  //last entry not above pressure
+  int lo = 0;
+  int hi = TABLE_LAST;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) / 2;
+    if (tableAt(mid) <= pressure) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  if (lo == TABLE_LAST) {
+    return TABLE_MAX;
+  }
+  Fixed low = tableAt(lo);
+  return Fixed(TABLE_MIN + lo) + (pressure - low) / (tableAt(lo + 1) - low);
+}
+
+Fixed Psychrometrics::relativeForAbsolute(Fixed absolute, Fixed temperature) {
+  Fixed pressure = absolute / WATER_FACTOR * (temperature + ZERO_CELSIUS);
+  return pressure / saturationPressure(temperature) * 100;
+}
+
+Fixed Psychrometrics::relativeForDewPoint(Fixed spread, Fixed temperature) {
+  return saturationPressure(temperature - spread) / saturationPressure(temperature) * 100;
+}
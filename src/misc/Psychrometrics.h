@@ -0,0 +1,62 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Psychrometrics.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef Psychrometrics_hpp
+#define Psychrometrics_hpp
+
+#include <Arduino.h>
+#include "misc/Fixed.h"
+
+//Moist air relations over water. Saturation vapour pressure comes from table
+//of Magnus formula for every whole degree in 0.1 Pa, values between are
+//interpolated (within 0.1 %), so no exp() or log() is evaluated.
+//Temperatures outside table are clamped.
+namespace Psychrometrics {
+  constexpr int TABLE_MIN = -20;
+  constexpr int TABLE_MAX = 60;
+
+  //Pa
+  Fixed saturationPressure(Fixed temperature);
+  //relative in %, result in g/m3
+  Fixed absoluteHumidity(Fixed relative, Fixed temperature);
+  Fixed dewPoint(Fixed relative, Fixed temperature);
+
+  //relative humidity (%) which holds given absolute humidity at temperature
+  Fixed relativeForAbsolute(Fixed absolute, Fixed temperature);
+  //relative humidity (%) at which dew point is spread degrees below temperature
+  Fixed relativeForDewPoint(Fixed spread, Fixed temperature);
+}
+
+#endif /* Psychrometrics_hpp */
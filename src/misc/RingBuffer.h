@@ -0,0 +1,144 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ RingBuffer.h
+ Created on: Oct 17, 2026
+ */
+#ifndef RingBuffer_hpp
+#define RingBuffer_hpp
+
+#include <cstddef>
+#include <iterator>
+
+//Fixed capacity FIFO on top of caller provided storage (usually static array),
+//when full push_back() overwrites oldest element. Index 0 is the oldest item.
+template<typename T, std::size_t N>
+class RingBuffer {
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    template<typename B, typename V>
+    class Iterator {
+      public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef V value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V* pointer;
+        typedef V& reference;
+
+        Iterator(B* buffer, size_type index) : buffer(buffer), index(index) {}
+
+        reference operator*() const { return (*buffer)[index]; }
+        pointer operator->() const { return &(*buffer)[index]; }
+        reference operator[](difference_type n) const { return (*buffer)[index + n]; }
+
+        Iterator& operator++() { index++; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; index++; return tmp; }
+        Iterator& operator--() { index--; return *this; }
+        Iterator operator--(int) { Iterator tmp = *this; index--; return tmp; }
+        Iterator& operator+=(difference_type n) { index += n; return *this; }
+        Iterator& operator-=(difference_type n) { index -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(buffer, index + n); }
+        Iterator operator-(difference_type n) const { return Iterator(buffer, index - n); }
+        difference_type operator-(const Iterator& other) const {
+          return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+        bool operator<(const Iterator& other) const { return index < other.index; }
+        bool operator>(const Iterator& other) const { return index > other.index; }
+        bool operator<=(const Iterator& other) const { return index <= other.index; }
+        bool operator>=(const Iterator& other) const { return index >= other.index; }
+      private:
+        B* buffer;
+        size_type index;
+    };
+
+    typedef Iterator<RingBuffer, T> iterator;
+    typedef Iterator<const RingBuffer, const T> const_iterator;
+
+    explicit RingBuffer(T* memory) : items(memory), head(0), count(0) {}
+
+    //returns true if oldest element was overwritten
+    bool push_back(const T& item) {
+      bool evicted = full();
+      items[(head + count) % N] = item;
+      if (evicted) {
+        head = (head + 1) % N;
+      } else {
+        count++;
+      }
+      return evicted;
+    }
+
+    void pop_front() {
+      if (count > 0) {
+        head = (head + 1) % N;
+        count--;
+      }
+    }
+
+    void pop_back() {
+      if (count > 0) {
+        count--;
+      }
+    }
+
+    void clear() {
+      head = 0;
+      count = 0;
+    }
+
+    T& operator[](size_type i) { return items[(head + i) % N]; }
+    const T& operator[](size_type i) const { return items[(head + i) % N]; }
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[count - 1]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+    size_type size() const { return count; }
+    static constexpr size_type capacity() { return N; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == N; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+  private:
+    T* items;
+    size_type head;
+    size_type count;
+};
+
+#endif /* RingBuffer_hpp */
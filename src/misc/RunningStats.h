@@ -0,0 +1,253 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ RunningStats.h
+ Created on: Oct 17, 2026
+ */
+#ifndef RunningStats_hpp
+#define RunningStats_hpp
+
+#include <Arduino.h>
+#include <algorithm>
+#include "misc/RingBuffer.h"
+#include "misc/Fixed.h"
+
+//Time weighted sums of value and its square. Values are kept in 1/256 %
+//(Fixed raw >> 8), so with weight in ms sums fit int64 for a week long
+//window. Integer sums make removal exact, window can slide forever without
+//drift.
+struct WeightedMoments {
+  static constexpr int VALUE_SHIFT = 8;
+
+  uint32_t weight = 0;
+  int64_t sum = 0;
+  int64_t sumSq = 0;
+
+  void add(Fixed value, uint32_t w) {
+    int64_t v = value.getRaw() >> VALUE_SHIFT;
+    weight += w;
+    sum += v * w;
+    sumSq += v * v * w;
+  }
+
+  void merge(const WeightedMoments& other) {
+    weight += other.weight;
+    sum += other.sum;
+    sumSq += other.sumSq;
+  }
+
+  void remove(const WeightedMoments& other) {
+    weight -= other.weight;
+    sum -= other.sum;
+    sumSq -= other.sumSq;
+  }
+
+  Fixed mean() const {
+    return weight > 0 ? Fixed::ratio(sum, static_cast<int64_t>(weight) << VALUE_SHIFT) : Fixed();
+  }
+
+  //(1/256 %)^2 equals Fixed resolution of %^2, so result is raw Fixed
+  Fixed variance() const {
+    if (weight == 0) {
+      return Fixed();
+    }
+    //sumSq - sum^2 / weight without overflowing sum^2, sum = m * weight + r
+    int64_t m = sum / weight;
+    int64_t r = sum % weight;
+    int64_t spread = sumSq - m * m * weight - 2 * m * r - r * r / weight;
+    return Fixed::fromRaw(spread > 0 ? spread / weight : 0);
+  }
+};
+
+//Statistics over sliding time window, window is split into N buckets and
+//slides by whole buckets. Every value is weighted by time it was held, so
+//irregular sampling does not skew results. All updates are O(1).
+template<std::size_t N>
+class RunningStats {
+  public:
+    //window in seconds, at least N
+    explicit RunningStats(uint32_t windowSec = N) :
+        bucketLen(windowSec * 1000UL / N), closed(closedBuff), minQueue(minBuff), maxQueue(maxBuff) {}
+    RunningStats(const RunningStats&) = delete;
+
+    //changing length drops collected data
+    void setWindow(uint32_t windowSec) {
+      uint32_t len = windowSec * 1000UL / N;
+      if ((len != bucketLen) and (len > 0)) {
+        bucketLen = len;
+        clear();
+      }
+    }
+
+    //timestamp in ms, see Clock::now()
+    void add(uint64_t timestamp, Fixed value, bool aboveTrigger) {
+      if (hasLast) {
+        uint32_t dt = timestamp - lastTimestamp;
+        current.moments.add(lastValue, dt);
+        current.aboveMs += lastAbove ? dt : 0;
+      }
+
+      uint32_t index = timestamp / bucketLen;
+      if (hasLast and (index != current.index)) {
+        closeBucket();
+        if (index >= N) {
+          evictOlderThan(index - N + 1);
+        }
+      }
+      if ((not hasLast) or (index != current.index)) {
+        current = Bucket();
+        current.index = index;
+        current.min = value;
+        current.max = value;
+      }
+      current.min = value < current.min ? value : current.min;
+      current.max = value > current.max ? value : current.max;
+
+      lastTimestamp = timestamp;
+      lastValue = value;
+      lastAbove = aboveTrigger;
+      hasLast = true;
+    }
+
+    Fixed getMean() const {
+      return getMoments().mean();
+    }
+
+    Fixed getStdDev() const {
+      return Fixed::sqrt(getMoments().variance());
+    }
+
+    Fixed getMin() const {
+      return minQueue.empty() ? current.min : std::min(minQueue.front().value, current.min);
+    }
+
+    Fixed getMax() const {
+      return maxQueue.empty() ? current.max : std::max(maxQueue.front().value, current.max);
+    }
+
+    //seconds spent above trigger within window
+    uint32_t getTimeAbove() const {
+      return (aboveMs + current.aboveMs) / 1000;
+    }
+
+    //seconds of data covered by window, at most window length
+    uint32_t getCovered() const {
+      return getMoments().weight / 1000;
+    }
+
+    uint32_t getWindow() const {
+      return bucketLen * N / 1000;
+    }
+
+    bool isEmpty() const {
+      return not hasLast;
+    }
+
+    void clear() {
+      hasLast = false;
+      total = WeightedMoments();
+      aboveMs = 0;
+      current = Bucket();
+      closed.clear();
+      minQueue.clear();
+      maxQueue.clear();
+    }
+  private:
+    struct Bucket {
+      uint32_t index = 0;
+      WeightedMoments moments;
+      uint32_t aboveMs = 0;
+      Fixed min;
+      Fixed max;
+    };
+
+    struct Extreme {
+      uint32_t index;
+      Fixed value;
+    };
+
+    uint32_t bucketLen;
+    Bucket current;
+    Bucket closedBuff[N];
+    RingBuffer<Bucket, N> closed;
+    WeightedMoments total;
+    uint32_t aboveMs = 0;
+    //monotonic queues of closed bucket extremes, front is window min/max
+    Extreme minBuff[N] = {};
+    Extreme maxBuff[N] = {};
+    RingBuffer<Extreme, N> minQueue;
+    RingBuffer<Extreme, N> maxQueue;
+
+    uint64_t lastTimestamp = 0;
+    Fixed lastValue;
+    bool lastAbove = false;
+    bool hasLast = false;
+
+    WeightedMoments getMoments() const {
+      WeightedMoments m = total;
+      m.merge(current.moments);
+      return m;
+    }
+
+    void closeBucket() {
+      if (closed.full()) {
+        evictOlderThan(closed.front().index + 1);
+      }
+      closed.push_back(current);
+      total.merge(current.moments);
+      aboveMs += current.aboveMs;
+
+      while ((not minQueue.empty()) and (minQueue.back().value >= current.min)) {
+        minQueue.pop_back();
+      }
+      minQueue.push_back(Extreme{current.index, current.min});
+      while ((not maxQueue.empty()) and (maxQueue.back().value <= current.max)) {
+        maxQueue.pop_back();
+      }
+      maxQueue.push_back(Extreme{current.index, current.max});
+    }
+
+    void evictOlderThan(uint32_t index) {
+      while ((not closed.empty()) and (closed.front().index < index)) {
+        total.remove(closed.front().moments);
+        aboveMs -= closed.front().aboveMs;
+        closed.pop_front();
+      }
+      while ((not minQueue.empty()) and (minQueue.front().index < index)) {
+        minQueue.pop_front();
+      }
+      while ((not maxQueue.empty()) and (maxQueue.front().index < index)) {
+        maxQueue.pop_front();
+      }
+    }
+};
+
+#endif /* RunningStats_hpp */
@@ -0,0 +1,135 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ SampleWindow.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef SampleWindow_hpp
+#define SampleWindow_hpp
+
+#include <Arduino.h>
+#include "misc/Fixed.h"
+#include "misc/RingBuffer.h"
+
+enum WindowMode_t {
+  WindowMode_SLIDING,   //oldest sample leaves when new one comes
+  WindowMode_TUMBLING   //window starts over when complete
+};
+
+//Mean and variance over last length (up to N) integer samples. Moments are
+//kept as exact integer sums, so samples can leave window without drift and
+//results are available after every add() in O(1).
+template<std::size_t N>
+class SampleWindow {
+  public:
+    SampleWindow(WindowMode_t mode, std::size_t length) :
+        mode(mode), length(0), samples(buff) {
+      setLength(length);
+    }
+    SampleWindow(const SampleWindow&) = delete;
+
+    //returns true when window holds length samples
+    bool add(int8_t value) {
+      if (isFull()) {
+        if (mode == WindowMode_TUMBLING) {
+          clear();
+        } else {
+          remove(samples.front());
+          samples.pop_front();
+        }
+      }
+      samples.push_back(value);
+      sum += value;
+      sumSq += value * value;
+      return isFull();
+    }
+
+    //window restarts when length changes
+    void setLength(std::size_t len) {
+      len = len < 1 ? 1 : len;
+      len = len > N ? N : len;
+      if (len != length) {
+        length = len;
+        clear();
+      }
+    }
+
+    void clear() {
+      samples.clear();
+      sum = 0;
+      sumSq = 0;
+    }
+
+    //oldest sample, next to leave sliding window
+    int8_t front() const {
+      return samples.front();
+    }
+
+    Fixed getMean() const {
+      return samples.empty() ? Fixed() : Fixed::ratio(sum, samples.size());
+    }
+
+    //sample variance, n - 1 in denominator, exact up to last fraction bit
+    Fixed getVariance() const {
+      int64_t n = samples.size();
+      if (n < 2) {
+        return Fixed();
+      }
+      return Fixed::ratio(n * sumSq - static_cast<int64_t>(sum) * sum, n * (n - 1));
+    }
+
+    Fixed getStdDev() const {
+      return Fixed::sqrt(getVariance());
+    }
+
+    std::size_t size() const {
+      return samples.size();
+    }
+
+    bool isFull() const {
+      return samples.size() >= length;
+    }
+  private:
+    WindowMode_t mode;
+    std::size_t length;
+    int8_t buff[N] = {};
+    RingBuffer<int8_t, N> samples;
+    int32_t sum = 0;
+    int32_t sumSq = 0;
+
+    void remove(int8_t value) {
+      sum -= value;
+      sumSq -= value * value;
+    }
+};
+
+#endif /* SampleWindow_hpp */
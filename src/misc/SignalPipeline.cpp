@@ -0,0 +1,128 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ SignalPipeline.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "misc/SignalPipeline.h"
+#include "misc/Prefs.h"
+
+constexpr StageInfo SignalPipeline::STAGES[];
+
+void SignalPipeline::assemble(const uint8_t (&config)[MAX_STAGES]) {
+  if (assembled and (memcmp(order, config, sizeof(order)) == 0)) {
+    return;
+  }
+  assembled = true;
+  memcpy(order, config, sizeof(order));
+  count = 0;
+  uint8_t used = 0;
+  while (count < MAX_STAGES) {
+    uint8_t type = order[count];
+    if ((stageName(static_cast<Stage_t>(type)) == nullptr) or (used & (1 << type))) {
+      break;
+    }
+    used |= 1 << type;
+    count++;
+  }
+
+  median.reset();
+  deadband.reset();
+  ema.reset();
+  kalman.reset();
+  rateLimiter.reset();
+}
+
+Fixed SignalPipeline::update(Fixed raw) {
+  input = raw;
+  Fixed value = raw;
+  for(std::size_t i = 0; i < count; i++) {
+    value = apply(static_cast<Stage_t>(order[i]), value);
+    outputs[i] = value;
+  }
+  return value;
+}
+
+Fixed SignalPipeline::apply(Stage_t type, Fixed value) {
+  switch(type) {
+    case Stage_MEDIAN:
+      return median.update(value, prefs.storage.medianSize);
+    case Stage_DEADBAND:
+      return deadband.update(value, Fixed::ratio(prefs.storage.deadband, 10));
+    case Stage_EMA:
+      return ema.update(value);
+    case Stage_KALMAN: {
+      //Q = 0 would shrink gain to zero and freeze output for good
+      Fixed q = Fixed::ratio(prefs.storage.kalmanQ > 0 ? prefs.storage.kalmanQ : 1, 1000);
+      Fixed r = Fixed::ratio(prefs.storage.kalmanR > 0 ? prefs.storage.kalmanR : 1, 1000);
+      return kalman.update(value, q, r);
+    }
+    case Stage_RATE_LIMIT:
+      return rateLimiter.update(value, Fixed::ratio(prefs.storage.rateLimit, 10));
+    default:
+      return value;
+  }
+}
+
+std::size_t SignalPipeline::size() const {
+  return count;
+}
+
+Stage_t SignalPipeline::getStage(std::size_t i) const {
+  return static_cast<Stage_t>(order[i]);
+}
+
+Fixed SignalPipeline::getOutput(std::size_t i) const {
+  return outputs[i];
+}
+
+Fixed SignalPipeline::getInput() const {
+  return input;
+}
+
+const char* SignalPipeline::stageName(Stage_t type) {
+  for(const StageInfo& info : STAGES) {
+    if (info.type == type) {
+      return info.name;
+    }
+  }
+  return nullptr;
+}
+
+Stage_t SignalPipeline::stageByName(const char* name, std::size_t len) {
+  for(const StageInfo& info : STAGES) {
+    if ((strlen(info.name) == len) and (strncmp(info.name, name, len) == 0)) {
+      return info.type;
+    }
+  }
+  return Stage_NONE;
+}
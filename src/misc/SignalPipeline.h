@@ -0,0 +1,100 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ SignalPipeline.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef SignalPipeline_hpp
+#define SignalPipeline_hpp
+
+#include <Arduino.h>
+#include "misc/Filters.h"
+
+//values are stored in prefs.storage.pipeline, don't reorder
+enum Stage_t : uint8_t {
+  Stage_NONE = 0,
+  Stage_MEDIAN = 1,
+  Stage_DEADBAND = 2,
+  Stage_EMA = 3,
+  Stage_KALMAN = 4,
+  Stage_RATE_LIMIT = 5
+};
+
+struct StageInfo {
+  Stage_t type;
+  const char* name;
+};
+
+//Chain of fixed memory filters applied to every sensor reading. Order is
+//taken from prefs.storage.pipeline (first Stage_NONE ends it), each stage
+//type can be used once. Output of every stage is kept for debugging.
+class SignalPipeline {
+  public:
+    static constexpr std::size_t MAX_STAGES = 5;
+    static constexpr std::size_t MAX_MEDIAN = 9;
+    static constexpr StageInfo STAGES[] = {
+      {Stage_MEDIAN, "median"},
+      {Stage_DEADBAND, "deadband"},
+      {Stage_EMA, "ema"},
+      {Stage_KALMAN, "kalman"},
+      {Stage_RATE_LIMIT, "rate"},
+    };
+
+    //rebuilds chain when prefs have changed, state of stages starts over
+    void assemble(const uint8_t (&order)[MAX_STAGES]);
+    Fixed update(Fixed raw);
+
+    std::size_t size() const;
+    Stage_t getStage(std::size_t i) const;
+    Fixed getOutput(std::size_t i) const;
+    Fixed getInput() const;
+
+    static const char* stageName(Stage_t type);
+    static Stage_t stageByName(const char* name, std::size_t len);
+  private:
+    uint8_t order[MAX_STAGES] = {};
+    std::size_t count = 0;
+    //empty ("none") pipeline is assembled too, count can't tell
+    bool assembled = false;
+    Fixed input;
+    Fixed outputs[MAX_STAGES];
+
+    MedianFilter<MAX_MEDIAN> median;
+    DeadbandFilter deadband;
+    EmaFilter ema{Fixed::ratio(9, 10)};
+    KalmanFilter kalman;
+    RateLimiter rateLimiter;
+
+    Fixed apply(Stage_t type, Fixed value);
+};
+
+#endif /* SignalPipeline_hpp */
@@ -0,0 +1,93 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TemplateRenderer.cpp
+ Created on: Oct 17, 2026
+ */
+#include "misc/TemplateRenderer.h"
+
+bool TemplateRenderer::add(const char* name, Field field) {
+  if (count == MAX_FIELDS) {
+    return false;
+  }
+  fields[count++] = {name, field};
+  return true;
+}
+
+TemplateRenderer::Field TemplateRenderer::find(const char* name) const {
+  for(std::size_t t = 0; t < count; t++) {
+    if (strcmp(fields[t].name, name) == 0) {
+      return fields[t].field;
+    }
+  }
+  return nullptr;
+}
+
+void TemplateRenderer::copy(PGM_P from, std::size_t len, Print& out) {
+  char buff[COPY_SIZE];
+  while (len > 0) {
+    std::size_t part = len < COPY_SIZE ? len : COPY_SIZE;
+    memcpy_P(buff, from, part);
+    out.write((const uint8_t*)buff, part);
+    from += part;
+    len -= part;
+  }
+}
+
+void TemplateRenderer::render(PGM_P page, Print& out) const {
+  PGM_P literal = page;
+  PGM_P pos = page;
+  char c;
+  while ((c = pgm_read_byte(pos)) != 0) {
+    if ((c != '$') or (pgm_read_byte(pos + 1) != '{')) {
+      pos++;
+      continue;
+    }
+    char name[MAX_NAME + 1];
+    std::size_t len = 0;
+    PGM_P end = pos + 2;
+    while ((len < MAX_NAME) and ((c = pgm_read_byte(end)) != 0) and (c != '}')) {
+      name[len++] = c;
+      end++;
+    }
+    name[len] = 0;
+    Field field = pgm_read_byte(end) == '}' ? find(name) : nullptr;
+    if (field == nullptr) {
+      pos++;
+      continue;
+    }
+    copy(literal, pos - literal, out);
+    field(out);
+    pos = end + 1;
+    literal = pos;
+  }
+  copy(literal, pos - literal, out);
+}
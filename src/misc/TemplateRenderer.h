@@ -0,0 +1,65 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TemplateRenderer.h
+ Created on: Oct 17, 2026
+ */
+#ifndef TemplateRenderer_hpp
+#define TemplateRenderer_hpp
+
+#include <Arduino.h>
+
+//Writes PROGMEM page to out in single pass. Literal text is copied from flash
+//in small pieces, each ${name} with registered field is replaced by what its
+//callback prints. Unknown placeholders are copied as they are.
+class TemplateRenderer {
+  public:
+    static constexpr std::size_t MAX_FIELDS = 32;
+    static constexpr std::size_t MAX_NAME = 31;
+    static constexpr std::size_t COPY_SIZE = 64;
+    typedef void (*Field)(Print& out);
+
+    //name must outlive renderer, false when there is no space for field
+    bool add(const char* name, Field field);
+    void render(PGM_P page, Print& out) const;
+  private:
+    struct Entry {
+      const char* name;
+      Field field;
+    };
+    Entry fields[MAX_FIELDS];
+    std::size_t count = 0;
+
+    Field find(const char* name) const;
+    static void copy(PGM_P from, std::size_t len, Print& out);
+};
+
+#endif /* TemplateRenderer_hpp */
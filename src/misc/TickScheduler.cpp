@@ -0,0 +1,114 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TickScheduler.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "misc/TickScheduler.h"
+#include <algorithm>
+
+TickScheduler::TickScheduler(uint32_t periodMs) : period(periodMs) {
+  reset();
+}
+
+void TickScheduler::reset() {
+  started = false;
+  nextTick = 0;
+  ticks = 0;
+  polls = 0;
+  lastJitter = 0;
+  maxJitter = 0;
+  sumJitter = 0;
+  overruns = 0;
+  dropped = 0;
+}
+
+uint32_t TickScheduler::poll(uint64_t now) {
+  if (not started) {
+    started = true;
+    nextTick = now;
+  }
+  if (now < nextTick) {
+    return 0;
+  }
+
+  uint64_t late = now - nextTick;
+  uint64_t due = late / period + 1;
+  nextTick += due * period;
+
+  lastJitter = late > UINT32_MAX ? UINT32_MAX : late;
+  maxJitter = std::max(maxJitter, lastJitter);
+  sumJitter += lastJitter;
+  polls++;
+
+  if (due > 1) {
+    overruns++;
+  }
+  if (due > MAX_CATCH_UP) {
+    dropped += due - MAX_CATCH_UP;
+    due = MAX_CATCH_UP;
+  }
+  ticks += due;
+  return due;
+}
+
+uint32_t TickScheduler::getPeriod() const {
+  return period;
+}
+
+uint64_t TickScheduler::getNextTick() const {
+  return nextTick;
+}
+
+uint32_t TickScheduler::getTicks() const {
+  return ticks;
+}
+
+uint32_t TickScheduler::getLastJitter() const {
+  return lastJitter;
+}
+
+uint32_t TickScheduler::getMaxJitter() const {
+  return maxJitter;
+}
+
+uint32_t TickScheduler::getMeanJitter() const {
+  return polls > 0 ? sumJitter / polls : 0;
+}
+
+uint32_t TickScheduler::getOverruns() const {
+  return overruns;
+}
+
+uint32_t TickScheduler::getDropped() const {
+  return dropped;
+}
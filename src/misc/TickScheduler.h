@@ -0,0 +1,79 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TickScheduler.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef TickScheduler_hpp
+#define TickScheduler_hpp
+
+#include <Arduino.h>
+
+//Fixed rate scheduler for control logic. Ticks are aligned to multiples of
+//period on the monotonic clock, so a slow loop() does not shift the phase.
+//Ticks missed during a stall are replayed (up to MAX_CATCH_UP at once) as
+//heuristics count calls and assume one call per period.
+class TickScheduler {
+  public:
+    static constexpr uint32_t MAX_CATCH_UP = 60;
+
+    TickScheduler(uint32_t periodMs);
+    //returns number of ticks which are due at now (ms)
+    uint32_t poll(uint64_t now);
+    void reset();
+
+    uint32_t getPeriod() const;
+    //due time of next tick (ms), 0 before first poll()
+    uint64_t getNextTick() const;
+    uint32_t getTicks() const;
+    //delay between due time and poll() of the last tick, ms
+    uint32_t getLastJitter() const;
+    uint32_t getMaxJitter() const;
+    uint32_t getMeanJitter() const;
+    //polls where more than one tick was due
+    uint32_t getOverruns() const;
+    //ticks skipped because catch up limit was exceeded
+    uint32_t getDropped() const;
+  private:
+    uint32_t period;
+    bool started;
+    uint64_t nextTick;
+    uint32_t ticks;
+    uint32_t polls;
+    uint32_t lastJitter;
+    uint32_t maxJitter;
+    uint64_t sumJitter;
+    uint32_t overruns;
+    uint32_t dropped;
+};
+
+#endif /* TickScheduler_hpp */
@@ -0,0 +1,70 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TriggerPolicy.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "misc/TriggerPolicy.h"
+#include "misc/Prefs.h"
+#include "misc/Psychrometrics.h"
+
+TriggerPolicy triggerPolicy;
+
+void TriggerPolicy::setTemperature(Fixed temperature) {
+  this->temperature = temperature;
+  hasTemperature = true;
+}
+
+void TriggerPolicy::clearTemperature() {
+  hasTemperature = false;
+}
+
+Fixed TriggerPolicy::getRelativeTrigger() const {
+  Fixed trigger = prefs.storage.humidityTrigger;
+  if (hasTemperature) {
+    switch(prefs.storage.triggerMode) {
+      case TriggerMode_ABSOLUTE:
+        trigger = Psychrometrics::relativeForAbsolute(Fixed::ratio(prefs.storage.absoluteTrigger, 10), temperature);
+        break;
+      case TriggerMode_DEW_POINT:
+        trigger = Psychrometrics::relativeForDewPoint(Fixed::ratio(prefs.storage.dewPointSpread, 10), temperature);
+        break;
+      default:
+        break;
+    }
+  }
+  return trigger < 0 ? Fixed() : (trigger > 100 ? Fixed(100) : trigger);
+}
+
+bool TriggerPolicy::isExceeded(int humidity) const {
+  return Fixed(humidity) > getRelativeTrigger();
+}
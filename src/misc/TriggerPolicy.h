@@ -0,0 +1,69 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ TriggerPolicy.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef TriggerPolicy_hpp
+#define TriggerPolicy_hpp
+
+#include <Arduino.h>
+#include "misc/Fixed.h"
+
+//values are stored in prefs.storage.triggerMode, don't reorder
+enum TriggerMode_t : uint8_t {
+  TriggerMode_RELATIVE = 0,   //humidityTrigger in %
+  TriggerMode_ABSOLUTE = 1,   //absoluteTrigger in 0.1 g/m3
+  TriggerMode_DEW_POINT = 2   //dewPointSpread in 0.1 C
+};
+
+//Decides when air is too wet. Absolute and dew point modes are converted
+//into relative humidity trigger at current temperature, so heuristics keep
+//comparing relative readings. Without temperature relative mode is used.
+class TriggerPolicy {
+  public:
+    //in C, fraction is kept so trigger does not jump when whole degree changes
+    void setTemperature(Fixed temperature);
+    //relative mode is used until temperature is set again
+    void clearTemperature();
+
+    //relative humidity (%) above which air is too wet, 0..100
+    Fixed getRelativeTrigger() const;
+    bool isExceeded(int humidity) const;
+  private:
+    Fixed temperature;
+    bool hasTemperature = false;
+};
+
+extern TriggerPolicy triggerPolicy;
+
+#endif /* TriggerPolicy_hpp */
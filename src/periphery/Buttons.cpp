@@ -36,6 +36,8 @@
 
 #include "misc/Prefs.h"
 #include "periphery/Buttons.h"
+#include "FlashLog.h"
+#include "TraceCapture.h"
 #include <Arduino.h>
 
 Buttons buttons;
@@ -60,5 +62,8 @@ void Buttons::update() {
 void Buttons::doFactorySettings() {
 	prefs.defaultValues();
 	prefs.save();
+	//keep buffered log entries and capture records, reset does not
+	traceCapture.stop();
+	flashLog.flush();
 	ESP.reset();
 }
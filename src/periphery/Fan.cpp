@@ -37,18 +37,33 @@
 #include "periphery/Fan.h"
 #include "misc/Prefs.h"
 
-Fan::Fan(uint8_t pin) : shouldRun(false), lastTurnOn(0), lastTurnOff(0), pin(pin), running(false) {
-  pinMode(pin, OUTPUT);
-  digitalWrite(pin, LOW);
+Fan::Fan(uint8_t pin, FanLog* log) : shouldRun(false), cause(FanCause_HEURISTIC), lastTurnOn(0),
+		lastTurnOff(0), pin(pin), running(false), requested(false), requestCause(FanCause_HEURISTIC), log(log) {
+	if (pin != NO_PIN) {
+		pinMode(pin, OUTPUT);
+		digitalWrite(pin, LOW);
+	}
 }
 
 void Fan::setFan(bool enabled) {
 	running = enabled;
-	Serial.println(enabled ? "Fan:ON" : "Fan:OFF");
-	digitalWrite(pin, enabled ? HIGH : LOW);
+	if (log != nullptr) {
+		log->onTransition(enabled, requestCause);
+	}
+	if (pin != NO_PIN) {
+		Serial.println(enabled ? "Fan:ON" : "Fan:OFF");
+		digitalWrite(pin, enabled ? HIGH : LOW);
+	}
 }
 
 void Fan::update() {
+	if (log != nullptr) {
+		log->account(running);
+	}
+	if (shouldRun != requested) {
+		requested = shouldRun;
+		requestCause = cause;
+	}
 	if (shouldRun) {
 		if ((not running) && (not tooEarly(lastTurnOff, prefs.storage.muteFanOn))) {
 			lastTurnOn = millis();
@@ -64,7 +79,7 @@ void Fan::update() {
 }
 
 bool Fan::tooEarly(unsigned long timestamp, uint8_t sec) {
-	return millis() < (timestamp + 1000 * sec);
+	return millis() - timestamp < 1000UL * sec;
 }
 
 bool Fan::isRunning() const {
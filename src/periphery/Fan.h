@@ -38,12 +38,17 @@
 #define SRC_FAN_H_
 
 #include <Arduino.h>
+#include "periphery/FanLog.h"
 
 class Fan {
 public:
+	//proxy fan, only tracks state, used to evaluate heuristics in shadow
+	static constexpr uint8_t NO_PIN = 255;
+
 	bool shouldRun;
+	FanCause_t cause;  //who has set shouldRun, may be reset every tick
 
-	Fan(uint8_t pin);
+	Fan(uint8_t pin, FanLog* log = nullptr);
 	void update();
 	bool isRunning() const;
 	unsigned long getTurnOnFanMillis() const;
@@ -52,6 +57,11 @@ private:
 	unsigned long lastTurnOff;
 	uint8_t pin;
 	bool running;
+	//shouldRun seen by last update() and cause of its last change, logged
+	//when mute time lets fan follow it
+	bool requested;
+	FanCause_t requestCause;
+	FanLog* log;
 
 	bool tooEarly(unsigned long timestamp, uint8_t sec);
 	void setFan(bool enabled);
@@ -0,0 +1,118 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ FanLog.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include "periphery/FanLog.h"
+#include "misc/Clock.h"
+
+FanLog fanLog;
+
+namespace {
+	constexpr uint32_t HOUR_MS = 3600 * 1000UL;
+	FanEvent eventBuff[FanLog::EVENT_COUNT];
+	uint16_t hourBuff[FanLog::HOUR_COUNT];
+	uint32_t dayBuff[FanLog::DAY_COUNT];
+}
+
+FanLog::FanLog() : events(eventBuff), hours(hourBuff), days(dayBuff), totalMs(0),
+		switchCount(0), hourStart(0), hourMs(0), dayMs(0), hoursInDay(0), lastAccount(0) {
+}
+
+void FanLog::onTransition(bool on, FanCause_t cause) {
+	//close runtime up to this moment with previous state
+	account(not on);
+	events.push_back(FanEvent(systemClock.seconds(), on, cause));
+	if (on) {
+		switchCount++;
+	}
+}
+
+void FanLog::account(bool running) {
+	uint64_t now = systemClock.now();
+	while (true) {
+		uint64_t hourEnd = hourStart + HOUR_MS;
+		bool crossed = now >= hourEnd;
+		uint64_t until = crossed ? hourEnd : now;
+		if (running) {
+			hourMs += until - lastAccount;
+			totalMs += until - lastAccount;
+		}
+		lastAccount = until;
+		if (not crossed) {
+			break;
+		}
+		closeHour();
+	}
+}
+
+void FanLog::closeHour() {
+	hours.push_back(hourMs / 1000);
+	dayMs += hourMs;
+	hourMs = 0;
+	hourStart += HOUR_MS;
+	hoursInDay++;
+	if (hoursInDay == 24) {
+		days.push_back(dayMs / 1000);
+		dayMs = 0;
+		hoursInDay = 0;
+	}
+}
+
+uint32_t FanLog::getTotalRuntime() const {
+	return totalMs / 1000;
+}
+
+uint32_t FanLog::getSwitchCount() const {
+	return switchCount;
+}
+
+uint32_t FanLog::getCurrentHour() const {
+	return hourMs / 1000;
+}
+
+uint32_t FanLog::getCurrentDay() const {
+	return (dayMs + hourMs) / 1000;
+}
+
+const char* fanCauseName(FanCause_t cause) {
+	switch(cause) {
+		case FanCause_MANUAL:
+			return "manual";
+		case FanCause_DISTURBER:
+			return "disturber";
+		default:
+		case FanCause_HEURISTIC:
+			return "heuristic";
+	}
+}
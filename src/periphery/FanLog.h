@@ -0,0 +1,94 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ FanLog.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FANLOG_H_
+#define SRC_FANLOG_H_
+
+#include <Arduino.h>
+#include "misc/RingBuffer.h"
+
+enum FanCause_t : uint8_t {
+  FanCause_HEURISTIC,
+  FanCause_MANUAL,
+  FanCause_DISTURBER
+};
+
+class __attribute__ ((packed)) FanEvent {
+public:
+	uint32_t timestamp;  //seconds since boot
+	uint8_t flags;  //bit 0 - turned on, bits 1..2 - cause
+
+	FanEvent() : timestamp(0), flags(0) {}
+	FanEvent(uint32_t timestamp, bool on, FanCause_t cause) :
+		timestamp(timestamp), flags((on ? 1 : 0) | (cause << 1)) {}
+	bool isOn() const { return (flags & 1) != 0; }
+	FanCause_t getCause() const { return static_cast<FanCause_t>((flags >> 1) & 0x3); }
+};
+
+//Transitions of real fan and its runtime per hour/day, counted incrementally
+class FanLog {
+public:
+	static constexpr std::size_t EVENT_COUNT = 64;
+	static constexpr std::size_t HOUR_COUNT = 24;
+	static constexpr std::size_t DAY_COUNT = 7;
+
+	RingBuffer<FanEvent, EVENT_COUNT> events;
+	RingBuffer<uint16_t, HOUR_COUNT> hours; //seconds of run in each closed hour
+	RingBuffer<uint32_t, DAY_COUNT> days;   //seconds of run in each closed day
+
+	FanLog();
+	void onTransition(bool on, FanCause_t cause);
+	void account(bool running);
+
+	uint32_t getTotalRuntime() const;
+	uint32_t getSwitchCount() const;
+	uint32_t getCurrentHour() const;
+	uint32_t getCurrentDay() const;
+private:
+	uint64_t totalMs;
+	uint32_t switchCount;
+	uint64_t hourStart;
+	uint32_t hourMs;
+	uint32_t dayMs;
+	uint8_t hoursInDay;
+	uint64_t lastAccount;
+
+	void closeHour();
+};
+
+extern FanLog fanLog;
+const char* fanCauseName(FanCause_t cause);
+
+#endif /* SRC_FANLOG_H_ */
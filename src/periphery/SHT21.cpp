@@ -25,6 +25,11 @@
 #define USER_REGISTER_READ    0xE7    //Read  user register
 #define HEATER_OFF 0xFB
 
+#define HUMD_CONVERSION_MS    29    //max time for 12 bit RH conversion
+#define TEMP_CONVERSION_MS    85    //max time for 14 bit T conversion
+#define POLL_INTERVAL_MS      5
+#define CONVERSION_TIMEOUT_MS 150
+
 void SHT21::begin(void){
   Wire.begin();
 
@@ -36,14 +41,134 @@ void SHT21::begin(void){
 
 float SHT21::getHumidity(void)
 {
-  const double d = readSHT21(TRIGGER_HUMD_MEASURE_NOHOLD);
-  return (-6.0 + 125.0 * d / 65536.0);
+  return rawToHumidity(readSHT21(TRIGGER_HUMD_MEASURE_NOHOLD));
 }
 
 float SHT21::getTemperature(void)
 {
-  const double d = readSHT21(TRIGGER_TEMP_MEASURE_NOHOLD);
-  return (-46.85 + 175.72 * d / 65536.0);
+  return rawToTemperature(readSHT21(TRIGGER_TEMP_MEASURE_NOHOLD));
+}
+
+float SHT21::rawToHumidity(uint16_t raw)
+{
+  return rawToHumidityFixed(raw).toFloat();
+}
+
+float SHT21::rawToTemperature(uint16_t raw)
+{
+  return rawToTemperatureFixed(raw).toFloat();
+}
+
+/**************************************************************************/
+/*
+    Datasheet formulas divide by 2^16, which is exactly the Q16.16 scale,
+    so scaled raw value is already the fraction.
+    RH = -6 + 125 * raw / 2^16
+    T = -46.85 + 175.72 * raw / 2^16
+*/
+/**************************************************************************/
+Fixed SHT21::rawToHumidityFixed(uint16_t raw)
+{
+  return Fixed::fromRaw(static_cast<int32_t>(raw) * 125) - 6;
+}
+
+Fixed SHT21::rawToTemperatureFixed(uint16_t raw)
+{
+  //175.72 * raw fits in 32 bits, 46.85 * 2^16 rounded
+  const uint32_t scaled = (static_cast<uint32_t>(raw) * 17572UL + 50) / 100;
+  return Fixed::fromRaw(static_cast<int32_t>(scaled) - 3070362L);
+}
+
+bool SHT21::triggerHumidity()
+{
+  return trigger(TRIGGER_HUMD_MEASURE_NOHOLD);
+}
+
+bool SHT21::triggerTemperature()
+{
+  return trigger(TRIGGER_TEMP_MEASURE_NOHOLD);
+}
+
+bool SHT21::trigger(uint8_t cmd)
+{
+  if (state == SHT21State_CONVERTING) {
+    return false;
+  }
+  //kept also on failure, so caller knows what to retry
+  command = cmd;
+  Wire.beginTransmission(SHT21_ADDRESS);
+  Wire.write(cmd);
+  if (Wire.endTransmission() != 0) {
+    state = SHT21State_ERROR;
+    return false;
+  }
+  triggerMillis = millis();
+  lastPollMillis = triggerMillis;
+  state = SHT21State_CONVERTING;
+  return true;
+}
+
+unsigned long SHT21::conversionTime() const
+{
+  return command == TRIGGER_TEMP_MEASURE_NOHOLD ? TEMP_CONVERSION_MS : HUMD_CONVERSION_MS;
+}
+
+/**************************************************************************/
+/*
+    Checks if conversion is done, in no hold master mode sensor NACKs read
+    header until result is available, so each poll costs one short I2C
+    transaction at most.
+*/
+/**************************************************************************/
+SHT21State_t SHT21::poll()
+{
+  if (state != SHT21State_CONVERTING) {
+    return state;
+  }
+
+  const unsigned long now = millis();
+  const unsigned long elapsed = now - triggerMillis;
+  if ((elapsed < conversionTime()) or (now - lastPollMillis < POLL_INTERVAL_MS)) {
+    return state;
+  }
+  lastPollMillis = now;
+
+  Wire.requestFrom(SHT21_ADDRESS, 3);
+  if (Wire.available() >= 3) {
+    uint8_t data[2];
+    data[0] = Wire.read();
+    data[1] = Wire.read();
+    uint8_t checksum = Wire.read();
+    if (crc8(data, sizeof(data)) != checksum) {
+      crcErrors++;
+      state = SHT21State_ERROR;
+      return state;
+    }
+    uint16_t result = (data[0] << 8) | data[1];
+    rawValue = result & ~0x0003;   // clear two low bits (status bits)
+    state = SHT21State_READY;
+
+  } else if (elapsed > CONVERSION_TIMEOUT_MS) {
+    timeouts++;
+    state = SHT21State_ERROR;
+  }
+  return state;
+}
+
+SHT21State_t SHT21::getState() const
+{
+  return state;
+}
+
+uint16_t SHT21::fetch()
+{
+  state = SHT21State_IDLE;
+  return rawValue;
+}
+
+void SHT21::clear()
+{
+  state = SHT21State_IDLE;
 }
 
 void SHT21::write8(uint8_t reg, uint8_t value)
@@ -64,32 +189,71 @@ uint8_t SHT21::read8(uint8_t command)
   Wire.beginTransmission(SHT21_ADDRESS);
   Wire.write(command);
   Wire.endTransmission();
-  delay(100);
 
   Wire.requestFrom(SHT21_ADDRESS, 1);
+  const unsigned long start = millis();
   while(Wire.available() < 1) {
+    if (millis() - start > CONVERSION_TIMEOUT_MS) {
+      return 0;
+    }
     delay(1);
   }
   return Wire.read();
 }
 
-uint16_t SHT21::readSHT21(uint8_t command)
+//true when pending or last conversion measures temperature
+bool SHT21::isTemperature() const
 {
-  uint16_t result;
+  return command == TRIGGER_TEMP_MEASURE_NOHOLD;
+}
 
-  Wire.beginTransmission(SHT21_ADDRESS);
-  Wire.write(command);
-  Wire.endTransmission();
-  delay(100);
+//reads rejected because of CRC mismatch
+uint32_t SHT21::getCrcErrors() const
+{
+  return crcErrors;
+}
 
-  Wire.requestFrom(SHT21_ADDRESS, 3);
-  while(Wire.available() < 3) {
-    delay(1);
+//conversions not finished within CONVERSION_TIMEOUT_MS
+uint32_t SHT21::getTimeouts() const
+{
+  return timeouts;
+}
+
+/**************************************************************************/
+/*
+    CRC-8 from datasheet: polynomial x^8 + x^5 + x^4 + 1 (0x31), init 0,
+    calculated over both result bytes, MSB first.
+*/
+/**************************************************************************/
+uint8_t SHT21::crc8(const uint8_t* data, uint8_t len)
+{
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t bit = 8; bit > 0; bit--) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : (crc << 1);
+    }
   }
+  return crc;
+}
 
-  // return result
-  result = ((Wire.read()) << 8);
-  result += Wire.read();
-  result &= ~0x0003;   // clear two low bits (status bits)
-  return result;
+/**************************************************************************/
+/*
+    Blocking read, waits at most CONVERSION_TIMEOUT_MS. Returns 0 on failure.
+*/
+/**************************************************************************/
+uint16_t SHT21::readSHT21(uint8_t command)
+{
+  if (not trigger(command)) {
+    clear();
+    return 0;
+  }
+  while(poll() == SHT21State_CONVERTING) {
+    delay(1);
+  }
+  if (state != SHT21State_READY) {
+    clear();
+    return 0;
+  }
+  return fetch();
 }
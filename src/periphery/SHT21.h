@@ -21,9 +21,17 @@
 
 #include <Wire.h>
 #include <Arduino.h>
+#include "misc/Fixed.h"
 
 #define SHT21_ADDRESS 0x40  //I2C address for the sensor
 
+enum SHT21State_t {
+  SHT21State_IDLE,        //nothing requested, trigger*() may be called
+  SHT21State_CONVERTING,  //conversion started, keep calling poll()
+  SHT21State_READY,       //result can be taken with fetch()
+  SHT21State_ERROR        //no ACK, conversion timed out or bad CRC, call clear()
+};
+
 class SHT21 {
 
 public:
@@ -31,7 +39,36 @@ public:
   float getHumidity(void);
   float getTemperature(void);
 
+  //Non blocking interface: trigger conversion, then call poll() from main loop
+  //until it reports READY (or ERROR). Sensor is not touched between polls.
+  bool triggerHumidity();
+  bool triggerTemperature();
+  SHT21State_t poll();
+  SHT21State_t getState() const;
+  uint16_t fetch();
+  void clear();
+  bool isTemperature() const;  //last triggered conversion
+  uint32_t getCrcErrors() const;
+  uint32_t getTimeouts() const;
+
+  static float rawToHumidity(uint16_t raw);
+  static float rawToTemperature(uint16_t raw);
+  //integer only conversion, used by control path
+  static Fixed rawToHumidityFixed(uint16_t raw);
+  static Fixed rawToTemperatureFixed(uint16_t raw);
+  static uint8_t crc8(const uint8_t* data, uint8_t len);
+
 private:
+  SHT21State_t state = SHT21State_IDLE;
+  uint8_t command = 0;
+  unsigned long triggerMillis = 0;
+  unsigned long lastPollMillis = 0;
+  uint16_t rawValue = 0;
+  uint32_t crcErrors = 0;
+  uint32_t timeouts = 0;
+
+  bool trigger(uint8_t command);
+  unsigned long conversionTime() const;
   uint16_t readSHT21(uint8_t command);
   uint8_t read8(uint8_t command);
   void write8(uint8_t reg, uint8_t value);
@@ -0,0 +1,264 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ bench.cpp
+ Created on: Oct 17, 2026
+ */
+
+//Compares fixed point control path with float code it replaced: sensor
+//conversion, filters and window statistics, plus whole default pipeline.
+//Host has FPU, so this shows cost of integer code and its error against
+//float, on ESP8266 float side is emulated and several times slower.
+//
+//  ./bench [iterations]
+
+#include <Arduino.h>
+#include <chrono>
+#include "heuristic/Heuristic.h"
+#include "misc/Fixed.h"
+#include "misc/Filters.h"
+#include "misc/Prefs.h"
+#include "misc/SampleWindow.h"
+#include "misc/SignalPipeline.h"
+#include "periphery/SHT21.h"
+
+namespace {
+
+  //float implementations replaced by fixed point ones
+  namespace reference {
+    float rawToHumidity(uint16_t raw) {
+      const double d = raw;
+      return (-6.0 + 125.0 * d / 65536.0);
+    }
+
+    float rawToTemperature(uint16_t raw) {
+      const double d = raw;
+      return (-46.85 + 175.72 * d / 65536.0);
+    }
+
+    struct Kalman {
+      bool initialized = false;
+      float output = 0;
+      float p = 0;
+
+      float update(float value, float q, float r) {
+        if (not initialized) {
+          output = value;
+          p = r;
+          initialized = true;
+          return output;
+        }
+        p += q;
+        float k = p / (p + r);
+        output += k * (value - output);
+        p *= 1.0f - k;
+        return output;
+      }
+    };
+
+    struct Ema {
+      float eta;
+      bool initialized = false;
+      float output = 0;
+
+      float update(float value) {
+        output = initialized ? (1.0f - eta) * value + eta * output : value;
+        initialized = true;
+        return output;
+      }
+    };
+
+    float stdDev(int32_t sum, int32_t sumSq, std::size_t n) {
+      float var = (sumSq - (float)sum * sum / n) / (n - 1);
+      return sqrt(var < 0 ? 0 : var);
+    }
+  }
+
+  //slow shower like rise with sensor noise, as raw SHT21 readings
+  struct Trace {
+    uint32_t seed = 12345;
+    uint32_t step = 0;
+
+    uint16_t next() {
+      seed = seed * 1103515245UL + 12345;
+      int noise = static_cast<int>((seed >> 16) % 400) - 200;
+      int base = 30000 + static_cast<int>((step++ % 2000) * 8);
+      return static_cast<uint16_t>(base + noise);
+    }
+  };
+
+  volatile float sinkFloat;
+  volatile int32_t sinkRaw;
+
+  struct Result {
+    const char* name;
+    double floatNs;
+    double fixedNs;
+    double maxError;
+  };
+
+  template<typename F>
+  double measure(uint32_t iterations, F body) {
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; i++) {
+      body();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+  }
+
+  void print(const Result& r) {
+    printf("  %-12s %10.1f %10.1f %12.6f\n", r.name, r.floatNs, r.fixedNs, r.maxError);
+  }
+
+  Result benchHumidity(uint32_t iterations) {
+    Result r = {"humidity", 0, 0, 0};
+    Trace trace;
+    r.floatNs = measure(iterations, [&]() { sinkFloat = reference::rawToHumidity(trace.next()); });
+    trace = Trace();
+    r.fixedNs = measure(iterations, [&]() { sinkRaw = SHT21::rawToHumidityFixed(trace.next()).getRaw(); });
+    for(uint32_t raw = 0; raw <= 0xFFFF; raw += 4) {
+      double error = fabs(reference::rawToHumidity(raw) - SHT21::rawToHumidityFixed(raw).toFloat());
+      r.maxError = std::max(r.maxError, error);
+    }
+    return r;
+  }
+
+  Result benchTemperature(uint32_t iterations) {
+    Result r = {"temperature", 0, 0, 0};
+    Trace trace;
+    r.floatNs = measure(iterations, [&]() { sinkFloat = reference::rawToTemperature(trace.next()); });
+    trace = Trace();
+    r.fixedNs = measure(iterations, [&]() { sinkRaw = SHT21::rawToTemperatureFixed(trace.next()).getRaw(); });
+    for(uint32_t raw = 0; raw <= 0xFFFF; raw += 4) {
+      double error = fabs(reference::rawToTemperature(raw) - SHT21::rawToTemperatureFixed(raw).toFloat());
+      r.maxError = std::max(r.maxError, error);
+    }
+    return r;
+  }
+
+  Result benchKalman(uint32_t iterations) {
+    Result r = {"kalman", 0, 0, 0};
+    const float q = prefs.storage.kalmanQ / 1000.0f;
+    const float rv = prefs.storage.kalmanR / 1000.0f;
+    const Fixed fq = Fixed::ratio(prefs.storage.kalmanQ, 1000);
+    const Fixed fr = Fixed::ratio(prefs.storage.kalmanR, 1000);
+
+    Trace trace;
+    reference::Kalman kf;
+    r.floatNs = measure(iterations, [&]() { sinkFloat = kf.update(reference::rawToHumidity(trace.next()), q, rv); });
+    trace = Trace();
+    KalmanFilter kx;
+    r.fixedNs = measure(iterations, [&]() {
+      sinkRaw = kx.update(SHT21::rawToHumidityFixed(trace.next()), fq, fr).getRaw();
+    });
+
+    trace = Trace();
+    kf = reference::Kalman();
+    kx.reset();
+    for(uint32_t i = 0; i < iterations; i++) {
+      uint16_t raw = trace.next();
+      float expected = kf.update(reference::rawToHumidity(raw), q, rv);
+      double error = fabs(expected - kx.update(SHT21::rawToHumidityFixed(raw), fq, fr).toFloat());
+      r.maxError = std::max(r.maxError, error);
+    }
+    return r;
+  }
+
+  Result benchEma(uint32_t iterations) {
+    Result r = {"ema", 0, 0, 0};
+    Trace trace;
+    reference::Ema ef{0.9f};
+    r.floatNs = measure(iterations, [&]() { sinkFloat = ef.update(reference::rawToHumidity(trace.next())); });
+    trace = Trace();
+    EmaFilter ex(Fixed::ratio(9, 10));
+    r.fixedNs = measure(iterations, [&]() { sinkRaw = ex.update(SHT21::rawToHumidityFixed(trace.next())).getRaw(); });
+
+    trace = Trace();
+    ef = reference::Ema{0.9f};
+    ex.reset();
+    for(uint32_t i = 0; i < iterations; i++) {
+      uint16_t raw = trace.next();
+      float expected = ef.update(reference::rawToHumidity(raw));
+      double error = fabs(expected - ex.update(SHT21::rawToHumidityFixed(raw)).toFloat());
+      r.maxError = std::max(r.maxError, error);
+    }
+    return r;
+  }
+
+  //sums are shared, only mean and standard deviation math differs
+  Result benchWindow(uint32_t iterations) {
+    Result r = {"window", 0, 0, 0};
+    static SampleWindow<MAX_NO_SAMPLES> window(WindowMode_SLIDING, MAX_NO_SAMPLES);
+    //volatile, so float math is not hoisted out of loop
+    volatile int32_t sum = 0;
+    volatile int32_t sumSq = 0;
+    Trace trace;
+    for(std::size_t i = 0; i < MAX_NO_SAMPLES; i++) {
+      int8_t value = SHT21::rawToHumidityFixed(trace.next()).toInt();
+      window.add(value);
+      sum = sum + value;
+      sumSq = sumSq + value * value;
+    }
+
+    r.floatNs = measure(iterations, [&]() {
+      sinkFloat = (float)sum / MAX_NO_SAMPLES + reference::stdDev(sum, sumSq, MAX_NO_SAMPLES);
+    });
+    r.fixedNs = measure(iterations, [&]() {
+      sinkRaw = (window.getMean() + window.getStdDev()).getRaw();
+    });
+    r.maxError = fabs(reference::stdDev(sum, sumSq, MAX_NO_SAMPLES) - window.getStdDev().toFloat());
+    return r;
+  }
+
+  double benchPipeline(uint32_t iterations) {
+    static SignalPipeline pipeline;
+    pipeline.assemble(prefs.storage.pipeline);
+    Trace trace;
+    return measure(iterations, [&]() { sinkRaw = pipeline.update(SHT21::rawToHumidityFixed(trace.next())).getRaw(); });
+  }
+}
+
+int main(int argc, char** argv) {
+  uint32_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+  iterations = iterations > 0 ? iterations : 1;
+  prefs.defaultValues();
+
+  printf("%u iterations, ns per call, max error against float\n", iterations);
+  printf("  %-12s %10s %10s %12s\n", "case", "float", "fixed", "maxError");
+  print(benchHumidity(iterations));
+  print(benchTemperature(iterations));
+  print(benchKalman(iterations));
+  print(benchEma(iterations));
+  print(benchWindow(iterations));
+  printf("  %-12s %21.1f\n", "pipeline", benchPipeline(iterations));
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ clock_test.cpp
+ Created on: Oct 17, 2026
+ */
+
+//Checks Clock against SNTP stand-in of host mock: anchoring to wall clock
+//in update(), following SNTP corrections and monotonic now() across
+//32 bit millis() wrap. Exit code is number of failed checks.
+
+#include <Arduino.h>
+#include "misc/Clock.h"
+
+namespace {
+  int failures = 0;
+
+  void check(bool ok, const char* what) {
+    printf("  %-48s %s\n", what, ok ? "ok" : "FAILED");
+    failures += ok ? 0 : 1;
+  }
+
+  //calls now() often enough to see every wrap, like main loop does
+  void advance(uint64_t ms) {
+    while (ms > 0) {
+      uint32_t step = ms > 60000 ? 60000 : ms;
+      hostAdvance(step);
+      systemClock.now();
+      ms -= step;
+    }
+  }
+
+  constexpr uint32_t BOOT_EPOCH = 1700000000;
+  constexpr uint64_t WRAP = 1ULL << 32;
+}
+
+int main() {
+  printf("clock:\n");
+  systemClock.begin();
+  check((hostSntpServer() != nullptr) and (strcmp(hostSntpServer(), SNTP_SERVER) == 0),
+      "begin() configures SNTP server");
+
+  advance(3000);
+  systemClock.update();
+  check(not systemClock.isAnchored(), "not anchored before SNTP answer");
+  check(systemClock.getBootEpoch() == 0, "boot epoch unknown before SNTP answer");
+
+  //server answers 4 s after boot, a second after previous check
+  advance(1000);
+  hostSntpAnswer((BOOT_EPOCH * 1000ULL) + hostMillis());
+  systemClock.update();
+  check(systemClock.isAnchored(), "anchored after SNTP answer");
+  check(systemClock.getBootEpoch() == BOOT_EPOCH, "boot epoch from SNTP time");
+
+  //correction of wall clock is followed, but only once per second
+  hostSntpAnswer(((BOOT_EPOCH + 2) * 1000ULL) + hostMillis());
+  systemClock.update();
+  check(systemClock.getBootEpoch() == BOOT_EPOCH, "update() checks SNTP at most once per second");
+  advance(1000);
+  systemClock.update();
+  check(systemClock.getBootEpoch() == BOOT_EPOCH + 2, "SNTP correction moves boot epoch");
+
+  //millis() wraps after 49.7 days
+  advance(WRAP - 1000 - hostMillis());
+  uint64_t before = systemClock.now();
+  check(millis() == WRAP - 1000 and before == WRAP - 1000, "now() equals millis() before wrap");
+  advance(1500);
+  uint64_t after = systemClock.now();
+  check(millis() == 500, "millis() wrapped");
+  check(after == WRAP + 500, "now() continues across wrap");
+  check(systemClock.seconds() == (WRAP + 500) / 1000, "seconds() continues across wrap");
+  systemClock.update();
+  check(systemClock.getBootEpoch() == BOOT_EPOCH + 2, "boot epoch stable across wrap");
+
+  advance(WRAP);
+  check(systemClock.now() == 2 * WRAP + 500, "second wrap counted");
+
+  printf("%s\n", failures == 0 ? "all passed" : "FAILED");
+  return failures;
+}
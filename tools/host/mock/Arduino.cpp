@@ -0,0 +1,88 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Arduino.cpp
+ Created on: Oct 17, 2026
+ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <Wire.h>
+#include <sys/time.h>
+
+HostSerial Serial;
+EEPROMClass EEPROM;
+TwoWire Wire;
+
+namespace {
+  uint64_t nowMs = 0;
+  const char* sntpServer = nullptr;
+  bool sntpAnswered = false;
+  int64_t wallOffset = 0;  //unix time in ms minus nowMs
+}
+
+//both wrap at 32 bits like on device
+unsigned long millis() {
+  return static_cast<uint32_t>(nowMs);
+}
+
+unsigned long micros() {
+  return static_cast<uint32_t>(nowMs * 1000);
+}
+
+void hostAdvance(uint32_t ms) {
+  nowMs += ms;
+}
+
+uint64_t hostMillis() {
+  return nowMs;
+}
+
+void configTime(int, int, const char* server) {
+  sntpServer = server;
+}
+
+const char* hostSntpServer() {
+  return sntpServer;
+}
+
+void hostSntpAnswer(uint64_t epochMs) {
+  sntpAnswered = true;
+  wallOffset = epochMs - nowMs;
+}
+
+//replaces libc one, Clock reads SNTP time through it
+extern "C" int gettimeofday(struct timeval* tv, void*) noexcept {
+  uint64_t wall = sntpAnswered ? nowMs + wallOffset : nowMs;
+  tv->tv_sec = wall / 1000;
+  tv->tv_usec = (wall % 1000) * 1000;
+  return 0;
+}
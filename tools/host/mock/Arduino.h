@@ -0,0 +1,89 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ Arduino.h
+ Created on: Oct 17, 2026
+ */
+
+#ifndef HostArduino_hpp
+#define HostArduino_hpp
+
+//Minimal Arduino API for native builds of control logic. Time is simulated,
+//replay advances it with hostAdvance() instead of waiting.
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+
+typedef uint8_t byte;
+
+#define PROGMEM
+inline uint16_t pgm_read_word(const void* p) { return *static_cast<const uint16_t*>(p); }
+inline uint32_t pgm_read_dword(const void* p) { return *static_cast<const uint32_t*>(p); }
+
+#define OUTPUT 1
+#define INPUT 0
+#define LOW 0
+#define HIGH 1
+
+unsigned long millis();
+unsigned long micros();
+void hostAdvance(uint32_t ms);
+uint64_t hostMillis();
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline void delay(unsigned long ms) { hostAdvance(ms); }
+inline void yield() {}
+
+//SNTP stand-in: configTime() only records server, gettimeofday() serves
+//simulated time since 1970 until hostSntpAnswer() sets wall clock
+void configTime(int, int, const char* server);
+const char* hostSntpServer();
+void hostSntpAnswer(uint64_t epochMs);
+
+class HostSerial {
+  public:
+    bool verbose = false;
+    void begin(unsigned long) {}
+    void flush() { fflush(stdout); }
+    void print(const char* s) { if (verbose) printf("%s", s); }
+    void print(long v) { if (verbose) printf("%ld", v); }
+    void println(const char* s) { if (verbose) printf("%s\n", s); }
+    void println(long v) { if (verbose) printf("%ld\n", v); }
+};
+
+extern HostSerial Serial;
+
+#endif /* HostArduino_hpp */
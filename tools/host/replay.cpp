@@ -0,0 +1,406 @@
+/*
+ BSD 3-Clause License
+
+ Copyright (c) 2017, The Tosters
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation
+ and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+ contributors may be used to endorse or promote products derived from
+ this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ replay.cpp
+ Created on: Oct 17, 2026
+ */
+
+//Replays recorded humidity traces through every heuristic in simulated time
+//and scores their decisions. Trace is CSV, one "seconds,humidity" sample per
+//line with optional third temperature column, lines starting with # are skipped. Samples may be change-only (as in
+//history or flash log), value is held until next sample. File downloaded from
+///capture is recognized by its header, its raw sensor words are filtered again
+//with pipeline from prefs.
+//
+//  ./replay [--set pref=value]... [--pipeline stage,...] [--onset-rise %]
+//           [--onset-window s] [--refractory s] trace.csv|capture.bin...
+
+#include <Arduino.h>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "misc/Prefs.h"
+#include "misc/SignalPipeline.h"
+#include "misc/TriggerPolicy.h"
+#include "periphery/SHT21.h"
+#include "CompressedHistory.h"
+#include "TraceCapture.h"
+#include "heuristic/HeuristicSet.h"
+
+namespace {
+
+  struct Sample {
+    uint32_t time;
+    float humidity;
+    float temperature;  //NAN when not measured
+  };
+
+  struct Options {
+    //rise within window which is treated as shower start
+    int onsetRise = 5;
+    uint32_t onsetWindow = 120;
+    //no new onset is detected for this long after previous one
+    uint32_t refractory = 30 * 60;
+    std::vector<std::string> traces;
+  };
+
+  struct Score {
+    uint32_t fanOnSec = 0;
+    //sum of humidity above trigger while fan was off, %*s
+    double excess = 0;
+    uint32_t switches = 0;
+    uint32_t reacted = 0;
+    uint32_t missed = 0;
+    uint64_t latencySum = 0;
+    uint64_t updateNs = 0;
+    uint64_t updates = 0;
+    bool wasRunning = false;
+    bool pending = false;
+  };
+
+  //Keeps minimum of last window seconds and reports shower onsets
+  class OnsetDetector {
+    public:
+      explicit OnsetDetector(const Options& opt) : opt(opt) {}
+
+      bool update(uint32_t t, int h) {
+        while ((not mins.empty()) and (mins.back().second >= h)) {
+          mins.pop_back();
+        }
+        mins.emplace_back(t, h);
+        while (mins.front().first + opt.onsetWindow < t) {
+          mins.pop_front();
+        }
+        bool quiet = (not started) or (t - lastOnset >= opt.refractory);
+        if (quiet and (h - mins.front().second >= opt.onsetRise)) {
+          started = true;
+          lastOnset = t;
+          return true;
+        }
+        return false;
+      }
+    private:
+      const Options& opt;
+      std::deque<std::pair<uint32_t, int>> mins;
+      bool started = false;
+      uint32_t lastOnset = 0;
+  };
+
+  struct PrefSetter {
+    const char* name;
+    std::function<void(long)> set;
+  };
+
+  const PrefSetter PREF_SETTERS[] = {
+    {"humidityTrigger", [](long v) { prefs.storage.humidityTrigger = v; }},
+    {"triggerMode", [](long v) { prefs.storage.triggerMode = v; }},
+    {"absoluteTrigger", [](long v) { prefs.storage.absoluteTrigger = v; }},
+    {"dewPointSpread", [](long v) { prefs.storage.dewPointSpread = v; }},
+    {"muteFanOn", [](long v) { prefs.storage.muteFanOn = v; }},
+    {"muteFanOff", [](long v) { prefs.storage.muteFanOff = v; }},
+    {"useDisturber", [](long v) { prefs.storage.useDisturber = v; }},
+    {"disturberTriggerTime", [](long v) { prefs.storage.disturberTriggerTime = v; }},
+    {"noSamples", [](long v) { prefs.storage.noSamples = v; }},
+    {"timeToForget", [](long v) { prefs.storage.timeToForget = v; }},
+    {"knownHumDiffTrigger", [](long v) { prefs.storage.knownHumDiffTrigger = v; }},
+    {"holtAlpha", [](long v) { prefs.storage.holtAlpha = v; }},
+    {"holtBeta", [](long v) { prefs.storage.holtBeta = v; }},
+    {"holtHorizon", [](long v) { prefs.storage.holtHorizon = v; }},
+    {"medianSize", [](long v) { prefs.storage.medianSize = v; }},
+    {"deadband", [](long v) { prefs.storage.deadband = v; }},
+    {"rateLimit", [](long v) { prefs.storage.rateLimit = v; }},
+    {"kalmanQ", [](long v) { prefs.storage.kalmanQ = v; }},
+    {"kalmanR", [](long v) { prefs.storage.kalmanR = v; }},
+  };
+
+  bool setPref(const std::string& arg) {
+    std::size_t eq = arg.find('=');
+    if (eq == std::string::npos) {
+      return false;
+    }
+    std::string name = arg.substr(0, eq);
+    for(const PrefSetter& setter : PREF_SETTERS) {
+      if (name == setter.name) {
+        setter.set(atol(arg.c_str() + eq + 1));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //stage names separated by comma, "none" for empty pipeline
+  bool setPipeline(const std::string& names) {
+    memset(prefs.storage.pipeline, Stage_NONE, sizeof(prefs.storage.pipeline));
+    if (names == "none") {
+      return true;
+    }
+    std::size_t count = 0;
+    std::istringstream in(names);
+    std::string name;
+    while (std::getline(in, name, ',')) {
+      Stage_t type = SignalPipeline::stageByName(name.c_str(), name.length());
+      if ((type == Stage_NONE) or (count == SignalPipeline::MAX_STAGES)) {
+        return false;
+      }
+      prefs.storage.pipeline[count++] = type;
+    }
+    return true;
+  }
+
+  //false when file is not a capture, device filter output is compared with
+  //current pipeline
+  bool loadCapture(const std::string& path, std::vector<Sample>& samples) {
+    std::ifstream in(path, std::ios::binary);
+    TraceCapture::Header header;
+    if ((not in.read((char*)&header, sizeof(header))) or (header.magic != TraceCapture::MAGIC) or
+        (header.recordSize != sizeof(TraceCapture::Record))) {
+      return false;
+    }
+    //pipeline steps once per second like on device, readings of a second are
+    //averaged, last one is held when there is none
+    static SignalPipeline pipeline;
+    pipeline.assemble(prefs.storage.pipeline);
+    uint64_t time = header.start * 1000ULL;
+    uint64_t nextStep = time + 1000;
+    float temperature = NAN;
+    Fixed sum;
+    Fixed last;
+    uint8_t inStep = 0;
+    bool hasOutput = false;
+    float output = 0;
+    bool compare = false;
+    uint32_t count = 0;
+    float maxDiff = 0;
+    TraceCapture::Record rec;
+    while (in.read((char*)&rec, sizeof(rec))) {
+      time += rec.dt;
+      while ((count > 0) and (time >= nextStep)) {
+        output = pipeline.update(inStep > 0 ? sum / inStep : last).toFloat();
+        samples.push_back({static_cast<uint32_t>(nextStep / 1000), output, temperature});
+        hasOutput = true;
+        compare = true;
+        sum = Fixed();
+        inStep = 0;
+        nextStep += 1000;
+      }
+      //device records its filter output at each reading, first one after step is compared
+      if (compare) {
+        float diff = fabsf(output - rec.filtered / 100.0f);
+        maxDiff = diff > maxDiff ? diff : maxDiff;
+        compare = false;
+      }
+      if (rec.flags & TraceCapture::FLAG_TEMPERATURE) {
+        temperature = SHT21::rawToTemperatureFixed(rec.raw).toFloat();
+        continue;
+      }
+      last = SHT21::rawToHumidityFixed(rec.raw);
+      sum += last;
+      inStep++;
+      count++;
+    }
+    printf("%s: capture of %u readings, largest difference to device filter %.2f %%\n",
+        path.c_str(), count, hasOutput ? maxDiff : 0.0f);
+    return true;
+  }
+
+  bool loadTrace(const std::string& path, std::vector<Sample>& samples) {
+    if (loadCapture(path, samples)) {
+      return not samples.empty();
+    }
+    std::ifstream in(path);
+    if (not in) {
+      return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty() or (line[0] == '#')) {
+        continue;
+      }
+      std::replace(line.begin(), line.end(), ',', ' ');
+      std::istringstream fields(line);
+      Sample s;
+      if (fields >> s.time >> s.humidity) {
+        float temperature;
+        s.temperature = fields >> temperature ? temperature : NAN;
+        samples.push_back(s);
+      }
+    }
+    std::sort(samples.begin(), samples.end(),
+        [](const Sample& a, const Sample& b) { return a.time < b.time; });
+    return not samples.empty();
+  }
+
+  void replay(const std::string& path, const std::vector<Sample>& samples, const Options& opt) {
+    static CompressedHistory::Block historyBuff[CompressedHistory::BLOCK_COUNT];
+    CompressedHistory history(historyBuff);
+    HeuristicSet heuristics(history);
+
+    Score scores[HeuristicId_COUNT];
+    OnsetDetector onsets(opt);
+    uint32_t onsetCount = 0;
+    uint32_t onsetTime = 0;
+    double aboveTrigger = 0;
+    std::size_t next = 0;
+    int humidity = 0;
+    float temperature = NAN;
+    const uint32_t first = samples.front().time;
+    const uint32_t last = samples.back().time;
+
+    //one control tick per simulated second, as on device
+    for(uint32_t t = first; t <= last; t++) {
+      while ((next < samples.size()) and (samples[next].time <= t)) {
+        humidity = lroundf(samples[next].humidity);
+        temperature = samples[next].temperature;
+        next++;
+      }
+      int8_t wholeTemperature = std::isnan(temperature) ? Measurement::NO_TEMPERATURE : lroundf(temperature);
+      if (history.empty() or (history.back().humidity != humidity) or
+          (history.back().temperature != wholeTemperature)) {
+        history.push_back(Measurement(t, humidity, wholeTemperature));
+      }
+      if (std::isnan(temperature)) {
+        triggerPolicy.clearTemperature();
+      } else {
+        triggerPolicy.setTemperature(Fixed::fromFloat(temperature));
+      }
+      float over = humidity - triggerPolicy.getRelativeTrigger().toFloat();
+      aboveTrigger += over > 0 ? over : 0;
+
+      bool onset = onsets.update(t, humidity);
+      if (onset) {
+        onsetCount++;
+        onsetTime = t;
+      }
+
+      for(const HeuristicInfo& info : HeuristicSet::REGISTERED) {
+        Score& score = scores[info.id];
+        Fan& fan = heuristics.getFan(info.id);
+        fan.cause = FanCause_HEURISTIC;
+        auto start = std::chrono::steady_clock::now();
+        heuristics.update(info.id, humidity);
+        auto stop = std::chrono::steady_clock::now();
+        score.updateNs += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+        score.updates++;
+        fan.update();
+
+        bool running = fan.isRunning();
+        if (onset) {
+          score.missed += score.pending ? 1 : 0;
+          score.pending = true;
+        }
+        if (running) {
+          score.fanOnSec++;
+          if (score.pending) {
+            score.pending = false;
+            score.reacted++;
+            score.latencySum += t - onsetTime;
+          }
+        } else {
+          score.excess += over > 0 ? over : 0;
+        }
+        score.switches += (running and not score.wasRunning) ? 1 : 0;
+        score.wasRunning = running;
+      }
+      hostAdvance(1000);
+    }
+
+    printf("%s: %u s, %u onsets, above trigger %.0f %%*s\n", path.c_str(), last - first + 1,
+        onsetCount, aboveTrigger);
+    printf("  %-11s %9s %12s %9s %11s %7s %10s\n", "heuristic", "fanOn[s]", "excess[%*s]",
+        "switches", "latency[s]", "missed", "ns/update");
+    for(const HeuristicInfo& info : HeuristicSet::REGISTERED) {
+      const Score& s = scores[info.id];
+      uint32_t missed = s.missed + (s.pending ? 1 : 0);
+      char latency[16] = "-";
+      if (s.reacted > 0) {
+        snprintf(latency, sizeof(latency), "%.1f", (double)s.latencySum / s.reacted);
+      }
+      printf("  %-11s %9u %12.0f %9u %11s %7u %10.0f\n", info.name, s.fanOnSec, s.excess,
+          s.switches, latency, missed, s.updates > 0 ? (double)s.updateNs / s.updates : 0.0);
+    }
+  }
+
+  int usage() {
+    fprintf(stderr, "usage: replay [--set pref=value]... [--pipeline stage,...] [--onset-rise %%] "
+        "[--onset-window s] [--refractory s] trace.csv|capture.bin...\nprefs:");
+    for(const PrefSetter& setter : PREF_SETTERS) {
+      fprintf(stderr, " %s", setter.name);
+    }
+    fprintf(stderr, "\n");
+    return 1;
+  }
+}
+
+int main(int argc, char** argv) {
+  prefs.defaultValues();
+  Options opt;
+  for(int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if ((arg == "--set") and hasValue) {
+      if (not setPref(argv[++i])) {
+        return usage();
+      }
+    } else if ((arg == "--pipeline") and hasValue) {
+      if (not setPipeline(argv[++i])) {
+        return usage();
+      }
+    } else if ((arg == "--onset-rise") and hasValue) {
+      opt.onsetRise = atoi(argv[++i]);
+    } else if ((arg == "--onset-window") and hasValue) {
+      opt.onsetWindow = atol(argv[++i]);
+    } else if ((arg == "--refractory") and hasValue) {
+      opt.refractory = atol(argv[++i]);
+    } else if (arg.compare(0, 2, "--") == 0) {
+      return usage();
+    } else {
+      opt.traces.push_back(arg);
+    }
+  }
+  if (opt.traces.empty()) {
+    return usage();
+  }
+
+  for(const std::string& path : opt.traces) {
+    std::vector<Sample> samples;
+    if (not loadTrace(path, samples)) {
+      fprintf(stderr, "%s: no samples\n", path.c_str());
+      return 1;
+    }
+    replay(path, samples, opt);
+  }
+  return 0;
+}